@@ -0,0 +1,181 @@
+#include "../src/core/engine.hpp"
+#include "../src/core/system_manager.hpp"
+#include "../src/core/system_pipeline.hpp"
+#include "../src/scenes/game_scene.hpp"
+#include "stress_scene_loader.hpp"
+#include "stress_driver_system.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Benchmark executable: runs the game's real system pipeline headless on procedurally
+ * generated stress scenes, for a sweep of entity counts, and reports per-system timings.
+ *
+ * Usage: benchmark [--ticks N] [--sizes 100,1000,5000] [--software-renderer]
+ *                  [--broadphase quadtree,linear,hash,sap] [--collision-threads N] [--workers N]
+ *
+ * --broadphase takes one or more collision broad phases; every size is run with each of them.
+ * --collision-threads caps the CollisionSystem's detection threads (default: all JobSystem threads).
+ * --workers sets the JobSystem's worker threads besides the main thread (default: one per remaining hardware thread).
+ *
+ * Timings are the profiler's rolling window, i.e. the last FrameProfiler::WINDOW_SIZE
+ * ticks of each run, after the scene has warmed up.
+ */
+
+namespace {
+    struct BenchmarkOptions {
+        uint64_t ticks = 1000;
+        std::vector<int> sizes = {100, 1000, 5000, 10000};
+        RenderBackend renderBackend = RenderBackend::None;
+        std::vector<BroadPhaseType> broadPhaseTypes = {BroadPhaseType::LinearQuadtree};
+        unsigned collisionThreadCount = 0;
+        int jobWorkerCount = -1;
+    };
+
+    const char* getBroadPhaseName(BroadPhaseType type) {
+        switch (type) {
+            case BroadPhaseType::Quadtree: return "quadtree";
+            case BroadPhaseType::LinearQuadtree: return "linear";
+            case BroadPhaseType::SpatialHash: return "hash";
+            case BroadPhaseType::SweepAndPrune: return "sap";
+        }
+        return "?";
+    }
+
+    bool parseBroadPhases(const std::string& list, std::vector<BroadPhaseType>& types) {
+        types.clear();
+        std::stringstream ss(list);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (item == "quadtree") types.push_back(BroadPhaseType::Quadtree);
+            else if (item == "linear") types.push_back(BroadPhaseType::LinearQuadtree);
+            else if (item == "hash") types.push_back(BroadPhaseType::SpatialHash);
+            else if (item == "sap") types.push_back(BroadPhaseType::SweepAndPrune);
+            else return false;
+        }
+        return !types.empty();
+    }
+
+    std::vector<int> parseSizes(const std::string& list) {
+        std::vector<int> sizes;
+        std::stringstream ss(list);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            const int size = std::atoi(item.c_str());
+            if (size > 0) sizes.push_back(size);
+        }
+        return sizes;
+    }
+
+    struct RunResult {
+        BroadPhaseType broadPhaseType = BroadPhaseType::LinearQuadtree;
+        int entitiesPerKind = 0;
+        int totalEntities = 0;
+        double tickAvgMs = 0.0;
+        double tickP99Ms = 0.0;
+        double entitiesPerSecond = 0.0;
+    };
+
+    RunResult runOnce(const BenchmarkOptions& options, int entitiesPerKind, BroadPhaseType broadPhaseType) {
+        const StressSceneConfig sceneConfig = StressSceneConfig::withEntitiesPerKind(entitiesPerKind);
+
+        EngineConfig engineConfig;
+        engineConfig.renderBackend = options.renderBackend;
+        engineConfig.maxTicks = options.ticks;
+        engineConfig.jobWorkerCount = options.jobWorkerCount;
+
+        RunResult result;
+        result.broadPhaseType = broadPhaseType;
+        result.entitiesPerKind = entitiesPerKind;
+        result.totalEntities = sceneConfig.getTotalEntityCount();
+
+        Engine engine;
+        if (!engine.init(engineConfig)) {
+            std::cerr << "Benchmark: Engine initialization failed." << std::endl;
+            return result;
+        }
+
+        auto scene = std::make_unique<GameScene>(std::make_unique<StressSceneLoader>(sceneConfig), "stress");
+
+        auto systemManager = std::make_unique<SystemManager>();
+        systemManager->setProfiler(engine.getProfiler());
+        systemManager->setJobSystem(engine.getJobSystem());
+        // Make the broad phase cover the whole generated world.
+        const QuadtreeRect worldBounds = {0, 0,
+            static_cast<int>(std::ceil(sceneConfig.worldWidth)), static_cast<int>(std::ceil(sceneConfig.worldHeight))};
+        addDefaultSystems(*systemManager, worldBounds, broadPhaseType, options.collisionThreadCount);
+        systemManager->addUpdateSystem(std::make_unique<StressDriverSystem>(sceneConfig.seed));
+        scene->setSystemManager(std::move(systemManager));
+
+        engine.registerScene("stress", std::move(scene));
+        engine.run("stress");
+
+        std::cout << "\n---- N = " << entitiesPerKind << " per kind (" << result.totalEntities << " entities), broad phase: "
+                  << getBroadPhaseName(broadPhaseType) << " ----" << std::endl;
+        std::cout << std::left << std::setw(36) << "Scope" << std::right
+                  << std::setw(10) << "avg ms" << std::setw(10) << "p99 ms" << std::endl;
+        for (const auto& stats : engine.getProfiler()->getAllStats()) {
+            if (stats.sampleCount == 0) continue;
+            std::cout << std::left << std::setw(36) << stats.name << std::right << std::fixed << std::setprecision(3)
+                      << std::setw(10) << stats.avgMs << std::setw(10) << stats.p99Ms << std::endl;
+            if (stats.name == "engine/update (tick)") {
+                result.tickAvgMs = stats.avgMs;
+                result.tickP99Ms = stats.p99Ms;
+            }
+        }
+
+        if (result.tickAvgMs > 0.0) {
+            result.entitiesPerSecond = result.totalEntities * (1000.0 / result.tickAvgMs);
+        }
+        return result;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--ticks" && i + 1 < argc) {
+            options.ticks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--sizes" && i + 1 < argc) {
+            options.sizes = parseSizes(argv[++i]);
+        } else if (arg == "--software-renderer") {
+            options.renderBackend = RenderBackend::Software;
+        } else if (arg == "--broadphase" && i + 1 < argc && parseBroadPhases(argv[i + 1], options.broadPhaseTypes)) {
+            ++i;
+        } else if (arg == "--collision-threads" && i + 1 < argc) {
+            options.collisionThreadCount = static_cast<unsigned>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--workers" && i + 1 < argc) {
+            options.jobWorkerCount = std::max(0, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: benchmark [--ticks N] [--sizes 100,1000,5000] [--software-renderer]"
+                      << " [--broadphase quadtree,linear,hash,sap] [--collision-threads N] [--workers N]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<RunResult> results;
+    for (const int size : options.sizes) {
+        for (const BroadPhaseType broadPhaseType : options.broadPhaseTypes) {
+            results.push_back(runOnce(options, size, broadPhaseType));
+        }
+    }
+
+    std::cout << "\n==================== BENCHMARK SUMMARY (" << options.ticks << " ticks per run) ====================" << std::endl;
+    std::cout << std::right << std::setw(10) << "N/kind" << std::setw(10) << "broad" << std::setw(12) << "entities"
+              << std::setw(14) << "tick avg ms" << std::setw(14) << "tick p99 ms" << std::setw(16) << "entities/s" << std::endl;
+    for (const auto& result : results) {
+        std::cout << std::setw(10) << result.entitiesPerKind << std::setw(10) << getBroadPhaseName(result.broadPhaseType)
+                  << std::setw(12) << result.totalEntities
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << result.tickAvgMs << std::setw(14) << result.tickP99Ms
+                  << std::setprecision(0) << std::setw(16) << result.entitiesPerSecond << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include "../../src/util/quadtree.hpp"
+#include "../../src/util/linear_quadtree.hpp"
+#include "../../src/util/sweep_and_prune.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Microbenchmark: the per-tick broad phase workload of the CollisionSystem (clear, insert
+ * every collider, one query per collider) on Quadtree<T> vs LinearQuadtree<T>, plus
+ * SweepAndPrune<T> finding all pairs directly. Objects move a little every pass, so the
+ * sweep-and-prune row shows the benefit of keeping its order between frames.
+ * Reports time per rebuild+query pass and heap allocations per pass after warm-up.
+ * The linear quadtree and sweep-and-prune rows test bounds with the AabbBatch kernels; --isa
+ * forces one instruction set instead of the best one the CPU supports.
+ *
+ * Usage: quadtree_microbench [--objects N] [--iterations N] [--isa scalar|sse2|avx2]
+ */
+
+// --- Allocation counting ---
+// Every heap allocation in this process goes through here, which is enough to tell
+// "allocates every frame" from "allocation free after warm-up".
+static std::atomic<uint64_t> g_allocationCount{0};
+
+void* operator new(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+    throw std::bad_alloc();
+}
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+namespace {
+    constexpr int WORLD_SIZE = 8192;
+    constexpr int WARMUP_ITERATIONS = 5;
+
+    struct Options {
+        int objects = 10000;
+        int iterations = 200;
+    };
+
+    struct Result {
+        double avgMs = 0.0;
+        double minMs = 0.0;
+        double allocationsPerPass = 0.0;
+        size_t checksum = 0;
+    };
+
+    std::vector<QuadtreeRect> makeScene(int count, uint32_t seed) {
+        // Mostly small, uniform colliders with a few large ones, like the stress scenes.
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> position(0, WORLD_SIZE - 64);
+        std::uniform_int_distribution<int> size(16, 48);
+        std::vector<QuadtreeRect> rects;
+        rects.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            const int scale = (i % 100 == 0) ? 8 : 1;
+            rects.push_back({position(rng), position(rng), size(rng) * scale, size(rng) * scale});
+        }
+        return rects;
+    }
+
+    // Moves every rect a little so each pass sees a slightly different scene, as in a real tick.
+    void jitter(std::vector<QuadtreeRect>& rects, std::mt19937& rng) {
+        std::uniform_int_distribution<int> step(-4, 4);
+        for (auto& rect : rects) {
+            rect.x = std::clamp(rect.x + step(rng), 0, WORLD_SIZE - rect.w);
+            rect.y = std::clamp(rect.y + step(rng), 0, WORLD_SIZE - rect.h);
+        }
+    }
+
+    template <typename Tree>
+    size_t runPass(Tree& tree, const std::vector<QuadtreeRect>& rects, std::vector<uint32_t>& found) {
+        tree.clear();
+        for (uint32_t i = 0; i < rects.size(); ++i) {
+            tree.insert(i, rects[i]);
+        }
+        size_t checksum = 0;
+        for (const auto& rect : rects) {
+            found.clear();
+            tree.query(rect, found);
+            checksum += found.size();
+        }
+        return checksum;
+    }
+
+    // Sweep-and-prune reports each pair once; count it like two queries would (both sides plus self).
+    size_t runPass(SweepAndPrune<uint32_t>& sweepAndPrune, const std::vector<QuadtreeRect>& rects,
+                   std::vector<std::pair<uint32_t, uint32_t>>& pairs) {
+        sweepAndPrune.clear();
+        for (uint32_t i = 0; i < rects.size(); ++i) {
+            sweepAndPrune.insert(i, rects[i]);
+        }
+        pairs.clear();
+        sweepAndPrune.queryPairs(pairs);
+        return rects.size() + 2 * pairs.size();
+    }
+
+    template <typename Tree, typename Scratch = std::vector<uint32_t>>
+    Result benchmark(Tree& tree, const Options& options) {
+        std::vector<QuadtreeRect> rects = makeScene(options.objects, 1234);
+        std::mt19937 rng(42);
+        Scratch found;
+        found.reserve(static_cast<size_t>(options.objects) * 4);
+
+        Result result;
+        result.minMs = 1e9;
+        for (int i = 0; i < WARMUP_ITERATIONS; ++i) {
+            runPass(tree, rects, found);
+        }
+
+        double totalMs = 0.0;
+        uint64_t allocations = 0;
+        for (int i = 0; i < options.iterations; ++i) {
+            jitter(rects, rng);
+            const uint64_t allocationsBefore = g_allocationCount.load(std::memory_order_relaxed);
+            const auto start = std::chrono::steady_clock::now();
+            result.checksum += runPass(tree, rects, found);
+            const auto end = std::chrono::steady_clock::now();
+            allocations += g_allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+            const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+            totalMs += ms;
+            result.minMs = std::min(result.minMs, ms);
+        }
+        result.avgMs = totalMs / options.iterations;
+        result.allocationsPerPass = static_cast<double>(allocations) / options.iterations;
+        return result;
+    }
+
+    bool parseInstructionSet(const std::string& name, AabbBatch::InstructionSet& instructionSet) {
+        for (const auto candidate : {AabbBatch::InstructionSet::Scalar, AabbBatch::InstructionSet::SSE2, AabbBatch::InstructionSet::AVX2}) {
+            if (name == AabbBatch::getInstructionSetName(candidate)) {
+                instructionSet = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void printResult(const char* name, const Result& result) {
+        std::cout << std::left << std::setw(16) << name << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(12) << result.avgMs << std::setw(12) << result.minMs
+                  << std::setprecision(1) << std::setw(16) << result.allocationsPerPass
+                  << std::setw(14) << result.checksum << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--objects" && i + 1 < argc) {
+            options.objects = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            options.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--isa" && i + 1 < argc) {
+            const std::string name = argv[++i];
+            AabbBatch::InstructionSet instructionSet;
+            if (!parseInstructionSet(name, instructionSet) || !AabbBatch::setInstructionSet(instructionSet)) {
+                std::cerr << "Instruction set '" << name << "' is not supported here." << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Usage: quadtree_microbench [--objects N] [--iterations N] [--isa scalar|sse2|avx2]" << std::endl;
+            return 1;
+        }
+    }
+
+    const QuadtreeRect worldBounds = {0, 0, WORLD_SIZE, WORLD_SIZE};
+    Quadtree<uint32_t> pointerTree(0, worldBounds);
+    LinearQuadtree<uint32_t> linearTree(worldBounds);
+    SweepAndPrune<uint32_t> sweepAndPrune;
+
+    std::cout << options.objects << " objects, " << options.iterations << " passes (clear + insert all + query all), "
+              << AabbBatch::getInstructionSetName(AabbBatch::getInstructionSet()) << " overlap tests\n";
+    std::cout << std::left << std::setw(16) << "Tree" << std::right << std::setw(12) << "avg ms"
+              << std::setw(12) << "min ms" << std::setw(16) << "allocs/pass" << std::setw(14) << "checksum" << std::endl;
+    printResult("Quadtree", benchmark(pointerTree, options));
+    printResult("LinearQuadtree", benchmark(linearTree, options));
+    printResult("SweepAndPrune", benchmark<SweepAndPrune<uint32_t>, std::vector<std::pair<uint32_t, uint32_t>>>(sweepAndPrune, options));
+    // Matching checksums mean every structure reported the same number of candidates.
+    return 0;
+}
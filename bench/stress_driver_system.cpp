@@ -0,0 +1,32 @@
+#include "stress_driver_system.hpp"
+#include "../src/components/intent.hpp"
+#include "../src/components/rigidbody.hpp"
+
+SystemAccess StressDriverSystem::getAccess() const {
+    return SystemAccess{}.write<StressAgentComponent, RigidBodyComponent, IntentComponent>();
+}
+
+void StressDriverSystem::update(entt::registry& registry, InputManager&, ResourceManager&, float deltaTime) {
+    std::uniform_real_distribution<float> randomInterval(0.5f, 2.0f);
+    std::uniform_int_distribution<int> randomAxis(-1, 1);
+    std::uniform_real_distribution<float> randomForce(-20000.0f, 20000.0f);
+
+    auto view = registry.view<StressAgentComponent, RigidBodyComponent>();
+    for (const auto entity : view) {
+        auto& agent = view.get<StressAgentComponent>(entity);
+        agent.timeUntilChange -= deltaTime;
+        if (agent.timeUntilChange > 0.0f) continue;
+        agent.timeUntilChange = randomInterval(m_rng);
+
+        if (auto* intent = registry.try_get<IntentComponent>(entity)) {
+            // Some agents stand still for a while, which exercises the idle <-> walk transitions.
+            intent->moveDirection = {static_cast<float>(randomAxis(m_rng)), static_cast<float>(randomAxis(m_rng))};
+        } else {
+            auto& rigidbody = view.get<RigidBodyComponent>(entity);
+            if (rigidbody.bodyType == BodyType::DYNAMIC) {
+                rigidbody.force.x += randomForce(m_rng) * rigidbody.mass;
+                rigidbody.force.y += randomForce(m_rng) * rigidbody.mass;
+            }
+        }
+    }
+}
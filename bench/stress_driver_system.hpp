@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../src/core/systems/isystem.hpp"
+#include <cstdint>
+#include <random>
+
+/**
+ * @struct StressAgentComponent
+ * @brief Marks a benchmark entity that the StressDriverSystem keeps in motion.
+ */
+struct StressAgentComponent {
+    float timeUntilChange = 0.0f;
+};
+
+/**
+ * @class StressDriverSystem
+ * @brief Stands in for player input and gameplay in the benchmark scenes.
+ * Every now and then it gives each agent a new random intent (FSM characters, which makes
+ * their state machines change state) or a push (dynamic bodies, so they never settle).
+ * Deterministic for a given seed.
+ */
+class StressDriverSystem : public IUpdateSystem {
+public:
+    explicit StressDriverSystem(uint32_t seed = 1234) : m_rng(seed) {}
+
+    const char* getName() const override { return "StressDriverSystem"; }
+    SystemAccess getAccess() const override;
+    void update(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager, float deltaTime) override;
+
+private:
+    std::mt19937 m_rng;
+};
@@ -0,0 +1,188 @@
+#include "stress_scene_loader.hpp"
+#include "stress_driver_system.hpp"
+#include "../src/core/context.hpp"
+#include "../src/core/blackboard_keys.hpp"
+#include "../src/core/fsm/simple_animation_state.hpp"
+#include "../src/util/resource_manager.hpp"
+
+// --- Component Includes ---
+#include "../src/components/tag.hpp"
+#include "../src/components/transform.hpp"
+#include "../src/components/sprite.hpp"
+#include "../src/components/rigidbody.hpp"
+#include "../src/components/collider.hpp"
+#include "../src/components/movement.hpp"
+#include "../src/components/intent.hpp"
+#include "../src/components/camera.hpp"
+#include "../src/components/blackboard.hpp"
+#include "../src/components/tilemap.hpp"
+#include "../src/components/statemachine/statemachine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace {
+    // Same layer bits the map loaders use.
+    constexpr uint32_t LAYER_WORLD = 1 << 0;
+    constexpr uint32_t LAYER_PLAYER = 1 << 1;
+
+    constexpr int TILE_SIZE = 16;
+
+    void setupSprite(entt::registry& registry, entt::entity entity, const SpriteAsset* asset,
+            SpriteAssetHandle handle, int16_t orderInLayer) {
+        auto& sprite = registry.emplace<SpriteComponent>(entity);
+        sprite.assetId = "player";
+        sprite.assetHandle = handle;
+        sprite.isAnimated = true;
+        sprite.orderInLayer = orderInLayer;
+        if (asset) {
+            sprite.width = asset->width;
+            sprite.height = asset->height;
+        }
+    }
+
+    void setupStateMachine(entt::registry& registry, entt::entity entity) {
+        auto& fsm = registry.emplace<StateMachineComponent>(entity);
+        fsm.currentState = "idle"_hs;
+        fsm.states["idle"_hs] = std::make_unique<SimpleAnimationState>("idle"_hs);
+        fsm.states["walk"_hs] = std::make_unique<SimpleAnimationState>("walk"_hs);
+
+        Transition toWalk;
+        toWalk.toState = "walk"_hs;
+        toWalk.conditions.emplace_back(BlackboardKeys::State::IsMoving, true);
+        fsm.transitions["idle"_hs].push_back(toWalk);
+
+        Transition toIdle;
+        toIdle.toState = "idle"_hs;
+        toIdle.conditions.emplace_back(BlackboardKeys::State::IsMoving, false);
+        fsm.transitions["walk"_hs].push_back(toIdle);
+
+        fsm.states["idle"_hs]->onEnter(entity, registry);
+    }
+}
+
+StressSceneConfig StressSceneConfig::withEntitiesPerKind(int n) {
+    StressSceneConfig config;
+    config.spriteCount = n;
+    config.dynamicBodyCount = n;
+    config.staticColliderCount = n;
+    config.fsmEntityCount = n;
+
+    // ~48x48 px of world per entity, never smaller than one screen.
+    const float side = std::sqrt(static_cast<float>(config.getTotalEntityCount())) * 48.0f;
+    config.worldWidth = std::max(static_cast<float>(DEFAULT_SCREEN_WIDTH), side);
+    config.worldHeight = std::max(static_cast<float>(DEFAULT_SCREEN_HEIGHT), side);
+    config.tilemapWidthInTiles = static_cast<int>(std::ceil(config.worldWidth / TILE_SIZE));
+    config.tilemapHeightInTiles = static_cast<int>(std::ceil(config.worldHeight / TILE_SIZE));
+    return config;
+}
+
+bool StressSceneLoader::load(entt::registry& registry, SDL_Renderer* renderer,
+                             ResourceManager* resourceManager, const std::string&) {
+    std::mt19937 rng(m_config.seed);
+    std::uniform_real_distribution<float> randomX(0.0f, m_config.worldWidth);
+    std::uniform_real_distribution<float> randomY(0.0f, m_config.worldHeight);
+    std::uniform_real_distribution<float> randomSpeed(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> randomSize(8.0f, 48.0f);
+
+    // --- Context Setup ---
+    int screenW = DEFAULT_SCREEN_WIDTH, screenH = DEFAULT_SCREEN_HEIGHT;
+    if (renderer && SDL_GetRendererOutputSize(renderer, &screenW, &screenH) != 0) {
+        screenW = DEFAULT_SCREEN_WIDTH;
+        screenH = DEFAULT_SCREEN_HEIGHT;
+    }
+    registry.ctx().emplace<ScreenDimensions>(static_cast<float>(screenW), static_cast<float>(screenH));
+
+    // --- Asset Preloading ---
+    const SpriteAsset* spriteAsset = resourceManager->loadSpriteAsset(renderer, "player");
+    const SpriteAssetHandle spriteHandle = resourceManager->getSpriteAssetHandle("player");
+    if (!spriteAsset) {
+        std::cerr << "StressSceneLoader: Could not load the 'player' sprite, sprites will be empty." << std::endl;
+    }
+
+    // --- Decorative sprites ---
+    for (int i = 0; i < m_config.spriteCount; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<TransformComponent>(entity, Vec2f{randomX(rng), randomY(rng)}, Vec2f{2.0f, 2.0f});
+        setupSprite(registry, entity, spriteAsset, spriteHandle, 1);
+    }
+
+    // --- Static colliders (like CodeMapLoader's collision objects) ---
+    for (int i = 0; i < m_config.staticColliderCount; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<TransformComponent>(entity, Vec2f{randomX(rng), randomY(rng)});
+        auto& collider = registry.emplace<ColliderComponent>(entity);
+        collider.size = {randomSize(rng), randomSize(rng)};
+        collider.layer = LAYER_WORLD;
+        collider.mask = LAYER_WORLD | LAYER_PLAYER;
+        collider.is_static = true;
+        registry.emplace<RigidBodyComponent>(entity, RigidBodyComponent{.bodyType = BodyType::STATIC, .mass = 0.0f});
+    }
+
+    // --- Dynamic bodies (like the CRATE) ---
+    for (int i = 0; i < m_config.dynamicBodyCount; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<TransformComponent>(entity, Vec2f{randomX(rng), randomY(rng)}, Vec2f{2.0f, 2.0f});
+        setupSprite(registry, entity, spriteAsset, spriteHandle, 9);
+        auto& collider = registry.emplace<ColliderComponent>(entity);
+        collider.size = {14.0f, 14.0f};
+        collider.layer = LAYER_WORLD;
+        collider.mask = LAYER_WORLD | LAYER_PLAYER;
+        auto& rigidbody = registry.emplace<RigidBodyComponent>(entity);
+        rigidbody.bodyType = BodyType::DYNAMIC;
+        rigidbody.mass = 10.0f;
+        rigidbody.restitution = 0.2f;
+        rigidbody.damping = 0.9f;
+        rigidbody.velocity = {randomSpeed(rng), randomSpeed(rng)};
+        registry.emplace<StressAgentComponent>(entity);
+    }
+
+    // --- FSM characters (like the Player, minus the input) ---
+    for (int i = 0; i < m_config.fsmEntityCount; ++i) {
+        const auto entity = registry.create();
+        registry.emplace<TransformComponent>(entity, Vec2f{randomX(rng), randomY(rng)}, Vec2f{2.0f, 2.0f});
+        setupSprite(registry, entity, spriteAsset, spriteHandle, 10);
+        auto& collider = registry.emplace<ColliderComponent>(entity);
+        collider.size = {10.0f, 14.0f};
+        collider.layer = LAYER_PLAYER;
+        collider.mask = LAYER_WORLD;
+        registry.emplace<RigidBodyComponent>(entity, RigidBodyComponent{.bodyType = BodyType::KINEMATIC, .damping = 0.9f});
+        registry.emplace<MovementComponent>(entity, 60.0f);
+        registry.emplace<IntentComponent>(entity);
+        registry.emplace<BlackboardComponent>(entity);
+        registry.emplace<StressAgentComponent>(entity);
+        setupStateMachine(registry, entity);
+    }
+
+    // --- Tilemap ---
+    if (m_config.tilemapWidthInTiles > 0 && m_config.tilemapHeightInTiles > 0) {
+        resourceManager->loadTilesetAsset(renderer, "ground", "ground.tileset");
+
+        const auto worldEntity = registry.create();
+        registry.emplace<TagComponent>(worldEntity, "World");
+        auto& tilemap = registry.emplace<TilemapComponent>(worldEntity);
+        tilemap.tileWidth = TILE_SIZE;
+        tilemap.tileHeight = TILE_SIZE;
+        tilemap.tilesetAssetId = "ground";
+
+        auto& layer = tilemap.layers.emplace_back();
+        layer.widthInTiles = m_config.tilemapWidthInTiles;
+        layer.heightInTiles = m_config.tilemapHeightInTiles;
+        layer.tileIds.resize(static_cast<size_t>(layer.widthInTiles) * layer.heightInTiles);
+        std::uniform_int_distribution<int> randomTile(1, 2);
+        for (auto& tileId : layer.tileIds) {
+            tileId = randomTile(rng);
+        }
+    }
+
+    // --- Camera, looking at the middle of the world ---
+    const auto camera = registry.create();
+    registry.emplace<TagComponent>(camera, "Camera");
+    registry.emplace<TransformComponent>(camera, Vec2f{m_config.worldWidth / 2.0f, m_config.worldHeight / 2.0f});
+    registry.emplace<CameraComponent>(camera);
+    registry.ctx().emplace<ActiveCamera>(camera);
+
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../src/core/scene_loader.hpp"
+#include <cstdint>
+
+/**
+ * @struct StressSceneConfig
+ * @brief Describes a procedurally generated benchmark scene.
+ */
+struct StressSceneConfig {
+    int spriteCount = 0;          // Animated sprites without physics (decoration).
+    int dynamicBodyCount = 0;     // Dynamic rigid bodies with solid colliders (crates).
+    int staticColliderCount = 0;  // Static collision boxes, like the map's collision objects.
+    int fsmEntityCount = 0;       // Kinematic, FSM-driven characters, set up like the player.
+    int tilemapWidthInTiles = 0;  // 0 disables the tilemap.
+    int tilemapHeightInTiles = 0;
+    float worldWidth = 1280.0f;   // Entities are scattered over [0, worldWidth) x [0, worldHeight).
+    float worldHeight = 720.0f;
+    uint32_t seed = 1234;         // Same seed, same scene.
+
+    /**
+     * @brief The reference workload: n of every entity kind, spread over a world that
+     * grows with n so the density (and so the number of contacts per entity) stays constant.
+     */
+    static StressSceneConfig withEntitiesPerKind(int n);
+
+    [[nodiscard]] int getTotalEntityCount() const {
+        return spriteCount + dynamicBodyCount + staticColliderCount + fsmEntityCount;
+    }
+};
+
+/**
+ * @class StressSceneLoader
+ * @brief Builds a StressSceneConfig scene directly in the registry, creating the same
+ * components (and the same asset setup) as the CodeSceneLoader/CodeMapLoader would.
+ */
+class StressSceneLoader : public ISceneLoader {
+public:
+    explicit StressSceneLoader(const StressSceneConfig& config) : m_config(config) {}
+
+    bool load(entt::registry& registry,
+              SDL_Renderer* renderer,
+              ResourceManager* resourceManager,
+              const std::string& sourcePath) override;
+
+private:
+    StressSceneConfig m_config;
+};
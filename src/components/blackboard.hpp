@@ -1,8 +1,12 @@
 #pragma once
 
-#include <string>
-#include <unordered_map>
-#include <any>
+#include "../core/math_types.hpp"
+#include <entt/entt.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <variant>
 
 /**
  * @file blackboard.hpp
@@ -14,9 +18,9 @@
  * to contribute to solving a larger problem, all without needing to know who wrote what.
  *
  * In this Entity-Component-System (ECS) context, the `BlackboardComponent`
- * serves as this shared space for a single entity. It uses a map with string
- * keys, allowing systems to store and retrieve data of any type (`std::any`)
- * by a well-known name.
+ * serves as this shared space for a single entity. Values are stored under
+ * well-known names, hashed at compile time (see `BlackboardKeys`), and hold
+ * one of a few small types: bool, int, float, entity or Vec2f.
  *
  * ### Purpose & Benefits
  * - **Decoupling:** A system that sets a "health" value doesn't need to know
@@ -33,11 +37,61 @@
  * @struct BlackboardComponent
  * @brief A generic, data-driven component for storing an entity's state.
  *
- * Systems can write to or read from the blackboard using string keys. This
+ * Systems can write to or read from the blackboard using hashed keys. This
  * decouples systems by allowing them to communicate through this shared data
  * store without needing to know about each other. It's the C++/ECS equivalent
  * of the parameter dictionaries found in engines like Godot and Unity.
+ *
+ * Entries live in a few fixed slots inside the component: a lookup compares the key
+ * against at most MAX_ENTRIES integers, and writing never allocates. String names only
+ * exist at authoring time; the scene loaders hash them when they fill the blackboard.
  */
 struct BlackboardComponent {
-    std::unordered_map<std::string, std::any> values;
-};
\ No newline at end of file
+    // A tagged union of the supported types; std::monostate marks an empty slot.
+    using Value = std::variant<std::monostate, bool, int, float, entt::entity, Vec2f>;
+
+    static constexpr size_t MAX_ENTRIES = 8;
+
+    /**
+     * @brief Stores value under key, replacing whatever was there, whatever its type.
+     * @return False if key is new and every slot is already taken.
+     */
+    template <typename T>
+    bool set(entt::id_type key, const T& value) {
+        static_assert(std::is_same_v<T, bool> || std::is_same_v<T, int> || std::is_same_v<T, float>
+            || std::is_same_v<T, entt::entity> || std::is_same_v<T, Vec2f>, "Unsupported blackboard value type");
+        size_t slot = findSlot(key);
+        if (slot == m_count) {
+            if (m_count == MAX_ENTRIES) return false;
+            m_keys[m_count++] = key;
+        }
+        m_values[slot].emplace<T>(value);
+        return true;
+    }
+
+    /**
+     * @brief The value stored under key, or nullptr if there is none or it holds another type.
+     */
+    template <typename T>
+    [[nodiscard]] const T* get(entt::id_type key) const {
+        const size_t slot = findSlot(key);
+        return slot < m_count ? std::get_if<T>(&m_values[slot]) : nullptr;
+    }
+
+    [[nodiscard]] bool contains(entt::id_type key) const { return findSlot(key) < m_count; }
+    [[nodiscard]] size_t size() const { return m_count; }
+
+private:
+    std::array<entt::id_type, MAX_ENTRIES> m_keys{};
+    std::array<Value, MAX_ENTRIES> m_values{};
+    uint8_t m_count = 0;
+
+    // The slot holding key, or m_count if there is none.
+    [[nodiscard]] size_t findSlot(entt::id_type key) const {
+        size_t slot = 0;
+        while (slot < m_count && m_keys[slot] != key) {
+            ++slot;
+        }
+        return slot;
+    }
+};
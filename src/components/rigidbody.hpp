@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../core/math_types.hpp"
+#include <cstdint>
 
 // Defines the physical behavior of a rigidbody in the simulation.
 enum class BodyType {
@@ -25,8 +26,25 @@ struct RigidBodyComponent {
     float restitution = 0.5f;
 
     float damping = 0.98f;
-    
+
+    // --- Sleeping (DYNAMIC bodies only) ---
+    // If false the body never falls asleep, e.g. for something the player must always be able to push.
+    bool canSleep = true;
+    // Consecutive ticks the body has moved slower than the scene's PhysicsSleepSettings::speedThreshold.
+    uint16_t restTicks = 0;
+
     // We can add more physics properties here in the future.
     // Vec2f acceleration{0.0f, 0.0f};
     // float friction = 0.1f;
 };
+
+/**
+ * @struct SleepingComponent
+ * @brief Tag present while a DYNAMIC body is asleep.
+ *
+ * The PhysicsSystem puts a body to sleep once it has been nearly still for a while. Sleeping
+ * bodies are not integrated and never initiate collision checks, so a pile of resting crates
+ * costs next to nothing. A body wakes up when a force or velocity is applied to it, or when an
+ * awake body collides with it.
+ */
+struct SleepingComponent {};
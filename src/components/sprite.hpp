@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <SDL2/SDL.h>
 #include "../core/entt_helpers.hpp"
+#include "../util/sprite_asset.hpp"
 
 /**
  * @struct SpriteComponent
@@ -16,6 +17,12 @@ struct SpriteComponent {
      * The RenderSystem will use this ID to fetch the actual texture from a resource manager.
      */
     std::string assetId;
+
+    /**
+     * @brief Handle of the asset named by assetId, resolved once by the scene loaders.
+     * Systems use this in the game loop so that no string hashing happens per frame.
+     */
+    SpriteAssetHandle assetHandle = INVALID_SPRITE_ASSET_HANDLE;
     
     int width = 0;
     int height = 0;
@@ -57,10 +64,41 @@ struct SpriteComponent {
      */
     float animationTimer = 0.0f;
 
+    /**
+     * @brief Cached pointer to the asset's sequence for currentState.
+     * Only re-resolved when currentState or the asset changes; see resolveSequence().
+     */
+    const AnimationSequence* currentSequence = nullptr;
+
+    /**
+     * @brief The state currentSequence was resolved for. 0 means "not resolved yet".
+     */
+    entt::id_type currentSequenceState = 0;
+
+    /**
+     * @brief The asset currentSequence points into, so switching assetId never reads a sequence
+     * of the previous asset. Assets live at a fixed address in the ResourceManager.
+     */
+    const SpriteAsset* currentSequenceAsset = nullptr;
+
     SpriteComponent() = default;
     SpriteComponent(std::string id, int w, int h, int16_t layer = 0, int16_t order = 0)
         : assetId(std::move(id)), width(w), height(h), sortingLayer(layer), orderInLayer(order) {}
 
+    /**
+     * @brief Returns the animation sequence for currentState, looking it up in the asset only
+     * when the state or the asset changed since the last call. Returns nullptr if the state has no animation.
+     */
+    const AnimationSequence* resolveSequence(const SpriteAsset& asset) {
+        if (currentSequenceState != currentState.value() || currentSequenceAsset != &asset) {
+            auto it = asset.animations.find(currentState);
+            currentSequence = (it != asset.animations.end()) ? &it->second : nullptr;
+            currentSequenceState = currentState.value();
+            currentSequenceAsset = &asset;
+        }
+        return currentSequence;
+    }
+
     /**
      * @brief Combines layer and order into a single key for efficient sorting.
      * @return A 32-bit integer where the high bits are the layer and the low bits are the order.
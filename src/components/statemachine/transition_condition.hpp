@@ -1,9 +1,9 @@
 #pragma once
-#include <string>
+#include <entt/entt.hpp>
 
 // Represents a condition that must be met for a transition to occur.
 // For now, it only supports checking boolean values on the blackboard.
 struct TransitionCondition {
-    std::string blackboardKey;
+    entt::id_type blackboardKey; // Hashed key name, e.g. BlackboardKeys::State::IsMoving.
     bool expectedValue;
 };
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct TileCollisionGridComponent
+ * @brief A per-map solidity bitmap, one bit per tile, used instead of one collider entity per wall.
+ *
+ * Lives on the tilemap entity. The grid starts at the world origin, like the tilemap itself.
+ * The CollisionSystem checks dynamic bodies only against the few cells they overlap.
+ * Built at load time from tile properties; later tile changes do not update it.
+ */
+struct TileCollisionGridComponent {
+    int widthInTiles = 0;
+    int heightInTiles = 0;
+    int tileWidth = 0;  // in pixels
+    int tileHeight = 0; // in pixels
+
+    // Physics layer/mask shared by every solid tile, same meaning as in ColliderComponent.
+    uint32_t layer = 0;
+    uint32_t mask = 0;
+
+    // Row-major bits, 64 tiles per word.
+    std::vector<uint64_t> solidBits;
+
+    void resize(int width, int height) {
+        widthInTiles = width;
+        heightInTiles = height;
+        solidBits.assign((static_cast<size_t>(width) * height + 63) / 64, 0);
+    }
+
+    [[nodiscard]] bool isSolid(int col, int row) const {
+        if (col < 0 || row < 0 || col >= widthInTiles || row >= heightInTiles) return false;
+        const size_t bit = static_cast<size_t>(row) * widthInTiles + col;
+        return (solidBits[bit / 64] >> (bit % 64)) & 1u;
+    }
+
+    void setSolid(int col, int row, bool solid) {
+        if (col < 0 || row < 0 || col >= widthInTiles || row >= heightInTiles) return;
+        const size_t bit = static_cast<size_t>(row) * widthInTiles + col;
+        if (solid) solidBits[bit / 64] |= (uint64_t{1} << (bit % 64));
+        else solidBits[bit / 64] &= ~(uint64_t{1} << (bit % 64));
+    }
+};
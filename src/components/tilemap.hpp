@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 
 /**
  * @struct TileLayer
@@ -20,8 +21,15 @@ struct TileLayer {
 /**
  * @struct TilemapComponent
  * @brief Holds all data for a tilemap instance.
+ *
+ * Renderers cache the map in baked chunks. Once loaded, change single tiles only through setTileId(),
+ * which marks the chunk for re-baking; writing to TileLayer::tileIds directly leaves stale chunks on screen.
+ * Replacing the whole component (registry.replace / patch) drops every cached chunk.
  */
 struct TilemapComponent {
+    // The map is rendered in square chunks of this many tiles per side.
+    static constexpr int CHUNK_SIZE_IN_TILES = 16;
+
     int tileWidth = 0;  // in pixels
     int tileHeight = 0; // in pixels
 
@@ -29,4 +37,40 @@ struct TilemapComponent {
     std::string tilesetAssetId;
 
     std::vector<TileLayer> layers;
+
+    // One counter per chunk (row-major), bumped whenever a tile inside that chunk changes.
+    // Renderers compare it with the revision they cached to know when to re-bake a chunk.
+    // Empty until the first tile change; a missing entry means revision 0.
+    std::vector<uint32_t> chunkRevisions;
+
+    [[nodiscard]] int getWidthInTiles() const { return layers.empty() ? 0 : layers[0].widthInTiles; }
+    [[nodiscard]] int getHeightInTiles() const { return layers.empty() ? 0 : layers[0].heightInTiles; }
+    [[nodiscard]] int getChunkColumns() const { return (getWidthInTiles() + CHUNK_SIZE_IN_TILES - 1) / CHUNK_SIZE_IN_TILES; }
+    [[nodiscard]] int getChunkRows() const { return (getHeightInTiles() + CHUNK_SIZE_IN_TILES - 1) / CHUNK_SIZE_IN_TILES; }
+
+    [[nodiscard]] uint32_t getChunkRevision(int chunkCol, int chunkRow) const {
+        const size_t index = static_cast<size_t>(chunkRow) * getChunkColumns() + chunkCol;
+        return index < chunkRevisions.size() ? chunkRevisions[index] : 0;
+    }
+
+    /**
+     * @brief Changes a single tile and invalidates the chunk that contains it.
+     * Always go through this method instead of writing to tileIds directly after loading,
+     * otherwise cached chunk textures will not be refreshed.
+     */
+    void setTileId(size_t layerIndex, int col, int row, int tileId) {
+        if (layerIndex >= layers.size()) return;
+        auto& layer = layers[layerIndex];
+        if (col < 0 || row < 0 || col >= layer.widthInTiles || row >= layer.heightInTiles) return;
+
+        int& current = layer.tileIds[row * layer.widthInTiles + col];
+        if (current == tileId) return;
+        current = tileId;
+
+        const int chunkCol = col / CHUNK_SIZE_IN_TILES;
+        const int chunkRow = row / CHUNK_SIZE_IN_TILES;
+        if (chunkCol >= getChunkColumns() || chunkRow >= getChunkRows()) return;
+        chunkRevisions.resize(static_cast<size_t>(getChunkColumns()) * getChunkRows(), 0);
+        chunkRevisions[chunkRow * getChunkColumns() + chunkCol]++;
+    }
 };
@@ -16,3 +16,13 @@ struct TransformComponent {
     TransformComponent(const Vec2f& pos, const Vec2f& scl = {1.0f, 1.0f}, float rot = 0.0f)
         : position(pos), scale(scl), rotation(rot) {}
 };
+
+/**
+ * @struct PreviousTransformComponent
+ * @brief Snapshot of an entity's position at the start of the current simulation tick.
+ * Written by the TransformHistorySystem. Render systems blend it with the TransformComponent
+ * so motion stays smooth when the simulation runs at a fixed rate.
+ */
+struct PreviousTransformComponent {
+    Vec2f position{0.0f, 0.0f};
+};
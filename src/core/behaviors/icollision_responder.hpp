@@ -24,10 +24,20 @@ public:
     virtual ~ICollisionResponder() = default;
 
     /**
-     * @brief The function that gets called when a collision occurs.
+     * @brief The function that gets called when a collision starts.
      * @param self The entity that owns this behavior component.
      * @param other The other entity involved in the collision.
      * @param registry The scene's entity registry.
      */
     virtual void onCollision(entt::entity self, entt::entity other, entt::registry& registry) = 0;
+
+    /**
+     * @brief Called every tick the two entities keep touching, if the scene reports stay events.
+     */
+    virtual void onCollisionStay(entt::entity self, entt::entity other, entt::registry& registry) {}
+
+    /**
+     * @brief Called once the two entities stop touching. `other` may already have been destroyed.
+     */
+    virtual void onCollisionEnd(entt::entity self, entt::entity other, entt::registry& registry) {}
 };
@@ -1,20 +1,23 @@
 #pragma once
 
+#include <entt/entt.hpp>
+
+// Keys are hashed at compile time; the strings are the names used in scene files.
 namespace BlackboardKeys {
 
     namespace State {
-        inline constexpr const char* IsMoving = "isMoving";
+        inline constexpr entt::hashed_string IsMoving{"isMoving"};
     }
 
     namespace Camera {
-        inline constexpr const char* FollowSpeed = "followSpeed";
-        inline constexpr const char* DeadZoneRadius = "deadZoneRadius";
-        inline constexpr const char* Target = "cameraTarget";
+        inline constexpr entt::hashed_string FollowSpeed{"followSpeed"};
+        inline constexpr entt::hashed_string DeadZoneRadius{"deadZoneRadius"};
+        inline constexpr entt::hashed_string Target{"cameraTarget"};
     }
 
     // We can add more categories as needed, for example:
     // namespace Combat {
-    //     inline constexpr const char* Health = "health";
-    //     inline constexpr const char* IsAttacking = "isAttacking";
+    //     inline constexpr entt::hashed_string Health{"health"};
+    //     inline constexpr entt::hashed_string IsAttacking{"isAttacking"};
     // }
 }
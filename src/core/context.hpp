@@ -3,6 +3,10 @@
 #include <entt/entt.hpp>
 #include <SDL2/SDL.h>
 
+// Logical screen size used when nothing else (window, renderer) provides one.
+inline constexpr int DEFAULT_SCREEN_WIDTH = 1280;
+inline constexpr int DEFAULT_SCREEN_HEIGHT = 720;
+
 struct ScreenDimensions {
     float w = 0.0f;
     float h = 0.0f;
@@ -15,3 +19,52 @@ struct WorldBounds {
 struct ActiveCamera {
     entt::entity entity{entt::null};
 };
+
+/**
+ * @struct RenderStats
+ * @brief Per-frame counters written by the RenderSystem.
+ * Useful to verify how many sprites are culled and how many draw calls the batching saves.
+ */
+struct RenderStats {
+    int spritesVisible = 0;    // Sprites inside the camera view that produced a quad this frame.
+    int spritesCulled = 0;     // Sprites rejected because they were outside the camera view.
+    int batches = 0;           // SDL_RenderGeometry calls issued this frame.
+    int vertices = 0;          // Vertices submitted across all batches this frame.
+};
+
+/**
+ * @struct RenderInterpolation
+ * @brief How far (0..1) the current frame is between the previous and the latest simulation tick.
+ * Set by the engine every frame; 1.0 means "draw the latest state as is".
+ */
+struct RenderInterpolation {
+    float alpha = 1.0f;
+};
+
+/**
+ * @struct BroadPhaseSettings
+ * @brief Scene-level tuning for the collision broad phase, read by the CollisionSystem on init.
+ * A scene file's `[world] broadPhaseCellSize` sets cellSize; non-positive values are ignored.
+ */
+struct BroadPhaseSettings {
+    float cellSize = 64.0f; // Spatial hash cell side, in world units. ~1-2x the typical collider size works best.
+};
+
+/**
+ * @struct CollisionEventSettings
+ * @brief Which CollisionEvents the CollisionSystem reports, read on init.
+ * `collisionStayEvents = true` in a scene file's [world] table turns on reportStay.
+ */
+struct CollisionEventSettings {
+    bool reportStay = false; // Also report every tick a pair keeps touching, not just Begin and End.
+};
+
+/**
+ * @struct PhysicsSleepSettings
+ * @brief When the PhysicsSystem puts resting DYNAMIC bodies to sleep, read on init.
+ * The [world] keys `sleepSpeed` and `sleepTicks` set speedThreshold and ticksToSleep; either may be left out.
+ */
+struct PhysicsSleepSettings {
+    float speedThreshold = 5.0f; // World units per second below which a body counts as resting.
+    int ticksToSleep = 30;       // Resting ticks in a row before it falls asleep. 0 disables sleeping.
+};
@@ -100,6 +100,7 @@ using ComponentDescriptorVariant = std::variant<
 struct EntityDescriptor {
     std::string name;
     std::vector<ComponentDescriptorVariant> components;
+    // bool, int, float or Vec2f values, or const char* entity names; hashed into the BlackboardComponent on load.
     std::unordered_map<std::string, std::any> blackboard;
 };
 
@@ -1,16 +1,25 @@
 #include "engine.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include "scene.hpp"
+#include "trace.hpp"
 #include "../scenes/game_scene.hpp"
 #include "../util/input_config_loader.hpp"
 
 Engine::Engine() = default;
 Engine::~Engine() {
+    if (Trace::isCapturing()) {
+        toggleTraceCapture(); // Don't lose a capture that was still running on quit.
+    }
     saveInputBindings();
     m_sceneManager.reset(); // Explicitly reset SceneManager before other managers
+    m_jobSystem.reset();
+    m_profiler.reset();
     m_inputManager.reset();
     m_resourceManager.reset();
     m_renderer.reset();
+    m_renderSurface.reset();
     m_window.reset();
     SDL_Quit();
 }
@@ -41,7 +50,52 @@ void Engine::loadInputConfig() {
     }
 }
 
-bool Engine::init() {
+bool Engine::init(const EngineConfig& config) {
+    m_config = config;
+    if (m_config.ticksPerSecond <= 0) {
+        std::cerr << "Warning: Invalid tick rate " << m_config.ticksPerSecond << ", using 60." << std::endl;
+        m_config.ticksPerSecond = 60;
+    }
+    m_config.maxTicksPerFrame = std::max(1, m_config.maxTicksPerFrame);
+
+    Trace::setThreadName("main");
+    if (m_config.traceOnStartup) {
+        Trace::beginCapture();
+    }
+
+    if (m_config.renderBackend != RenderBackend::Window) {
+        // Headless: no window, no display needed. Events are still pumped so SDL_QUIT
+        // (e.g. Ctrl+C) ends the run cleanly.
+        if (!initHeadless()) {
+            return false;
+        }
+    } else if (!initWindow()) {
+        return false;
+    }
+
+    // Initialize managers and systems
+    m_resourceManager = std::make_unique<ResourceManager>();
+    m_inputManager = std::make_unique<InputManager>(8000);
+    m_profiler = std::make_unique<FrameProfiler>();
+    m_updateScope = m_profiler->registerScope("engine/update (tick)");
+    m_renderScope = m_profiler->registerScope("engine/render");
+    m_presentScope = m_profiler->registerScope("engine/present (vsync wait)");
+    m_jobSystem = std::make_unique<JobSystem>(m_config.jobWorkerCount);
+    m_jobSystem->setProfiler(m_profiler.get());
+
+    initUserConfigPath();
+    loadInputConfig();
+
+    // SceneManager is created last as it may depend on the others for its scenes.
+    m_sceneManager = std::make_unique<SceneManager>(m_renderer.get(),
+        m_resourceManager.get(), m_inputManager.get());
+
+    m_lastFrameTime = SDL_GetPerformanceCounter();
+    m_isRunning = true;
+    return true;
+}
+
+bool Engine::initWindow() {
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
         std::cerr << "SDL Initialization Error: " << SDL_GetError() << std::endl;
         return false;
@@ -56,8 +110,8 @@ bool Engine::init() {
         "1-Bit Playground",
         SDL_WINDOWPOS_CENTERED,
         SDL_WINDOWPOS_CENTERED,
-        1280,
-        720,
+        m_config.screenWidth,
+        m_config.screenHeight,
         SDL_WINDOW_SHOWN
     ));
 
@@ -76,26 +130,44 @@ bool Engine::init() {
         std::cerr << "Renderer Creation Error: " << SDL_GetError() << std::endl;
         return false;
     }
+    return true;
+}
 
-    // Initialize managers and systems
-    m_resourceManager = std::make_unique<ResourceManager>();
-    m_inputManager = std::make_unique<InputManager>(8000);
+bool Engine::initHeadless() {
+    if (SDL_Init(SDL_INIT_EVENTS | SDL_INIT_TIMER) != 0) {
+        std::cerr << "SDL Initialization Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
 
-    initUserConfigPath();
-    loadInputConfig();
+    if (m_config.renderBackend == RenderBackend::None) {
+        std::cout << "Engine: Running headless without a renderer." << std::endl;
+        return true;
+    }
 
-    // SceneManager is created last as it may depend on the others for its scenes.
-    m_sceneManager = std::make_unique<SceneManager>(m_renderer.get(),
-        m_resourceManager.get(), m_inputManager.get());
+    // Software backend: render systems draw into an offscreen surface on the CPU.
+    m_renderSurface.reset(SDL_CreateRGBSurfaceWithFormat(0, m_config.screenWidth, m_config.screenHeight,
+        32, SDL_PIXELFORMAT_RGBA8888));
+    if (!m_renderSurface) {
+        std::cerr << "Offscreen Surface Creation Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
 
-    m_lastFrameTime = SDL_GetPerformanceCounter();
-    m_isRunning = true;
+    m_renderer.reset(SDL_CreateSoftwareRenderer(m_renderSurface.get()));
+    if (!m_renderer) {
+        std::cerr << "Software Renderer Creation Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    std::cout << "Engine: Running headless with SDL's software renderer ("
+              << m_config.screenWidth << "x" << m_config.screenHeight << ")." << std::endl;
     return true;
 }
 
 void Engine::saveInputBindings() {
     // Don't save if we don't have an input manager.
     if (!m_inputManager) return;
+    // Headless runs never change bindings, leave the user's file alone.
+    if (m_config.renderBackend != RenderBackend::Window) return;
 
     char* prefPath = SDL_GetPrefPath("Fabz", "1bit-playground");
     if (!prefPath) {
@@ -110,17 +182,80 @@ void Engine::saveInputBindings() {
     InputConfigLoader::saveToFile(*m_inputManager, configFilePath);
 }
 
+void Engine::toggleTraceCapture() {
+    if (!Trace::isCapturing()) {
+        Trace::beginCapture();
+        return;
+    }
+
+    // Traces go next to the user's input config, one file per capture.
+    char* prefPath = SDL_GetPrefPath("Fabz", "1bit-playground");
+    std::string directory = prefPath ? std::string(prefPath) : std::string();
+    SDL_free(prefPath);
+
+    const std::string filePath = directory + "trace_" + std::to_string(SDL_GetTicks()) + ".json";
+    Trace::endCapture(filePath);
+}
+
 void Engine::run(const std::string& initialSceneId) {
     m_sceneManager->switchTo(initialSceneId);
     mainLoop();
 }
 
 void Engine::mainLoop() {
-     while (m_isRunning) {
+    const double tickDuration = 1.0 / m_config.ticksPerSecond;
+    double accumulator = 0.0;
+    // Headless runs are benchmarks: step one tick per iteration as fast as possible,
+    // independent of wall-clock time.
+    const bool isHeadless = m_config.renderBackend != RenderBackend::Window;
+
+    // Don't count the time spent loading the initial scene as the first frame.
+    m_lastFrameTime = SDL_GetPerformanceCounter();
+    const uint64_t loopStartTime = m_lastFrameTime;
+
+    while (m_isRunning) {
+        TRACE_ZONE("Engine::frame");
+        const uint64_t now = SDL_GetPerformanceCounter();
+        const double frameTime = (now - m_lastFrameTime) / static_cast<double>(SDL_GetPerformanceFrequency());
+        m_lastFrameTime = now;
+
         handleEvents();
-        update();
+
+        if (isHeadless) {
+            update(static_cast<float>(tickDuration));
+            m_sceneManager->setInterpolationAlpha(1.0f);
+        } else if (!m_config.fixedTimestep) {
+            update(static_cast<float>(frameTime));
+            m_sceneManager->setInterpolationAlpha(1.0f);
+        } else {
+            // --- Fixed timestep ---
+            // Consume the elapsed time in constant-size ticks; whatever is left over is
+            // used to blend between the last two ticks when rendering.
+            accumulator += frameTime;
+            int ticks = 0;
+            while (accumulator >= tickDuration && ticks < m_config.maxTicksPerFrame && m_isRunning) {
+                update(static_cast<float>(tickDuration));
+                accumulator -= tickDuration;
+                ++ticks;
+            }
+            if (accumulator >= tickDuration) {
+                // Too far behind (hitch, breakpoint, window drag...), drop the backlog.
+                accumulator = std::fmod(accumulator, tickDuration);
+            }
+            m_sceneManager->setInterpolationAlpha(static_cast<float>(accumulator / tickDuration));
+        }
+
         render();
     }
+
+    if (isHeadless) {
+        const double elapsed = (SDL_GetPerformanceCounter() - loopStartTime) / static_cast<double>(SDL_GetPerformanceFrequency());
+        std::cout << "Engine: Headless run finished, " << m_tickCount << " ticks in " << elapsed << " s ("
+                  << (elapsed > 0.0 ? m_tickCount / elapsed : 0.0) << " ticks/s)." << std::endl;
+    }
+    if (m_config.dumpProfileOnExit && m_profiler) {
+        m_profiler->dump(std::cout);
+    }
 }
 
 void Engine::registerScene(const std::string& id, std::unique_ptr<Scene> scene) {
@@ -128,38 +263,65 @@ void Engine::registerScene(const std::string& id, std::unique_ptr<Scene> scene)
 }
 
 void Engine::handleEvents() {
-    m_inputManager->prepareForUpdate();
-
+    TRACE_ZONE("Engine::handleEvents");
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) {
             m_isRunning = false;
+        } else if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+            // Target textures are blank now; anything baked into them has to be redrawn.
+            m_sceneManager->onRenderTargetsReset();
         }
         m_inputManager->handleEvent(event);
         m_sceneManager->handleEvents(event);
     }
 }
 
-void Engine::update() {
-    uint64_t now = SDL_GetPerformanceCounter();
-    float deltaTime = (now - m_lastFrameTime) / static_cast<float>(SDL_GetPerformanceFrequency());
-    m_lastFrameTime = now;
+void Engine::update(float deltaTime) {
+    ++m_tickCount;
+    if (m_config.maxTicks > 0 && m_tickCount >= m_config.maxTicks) {
+        m_isRunning = false; // Finish this tick and frame, then leave the main loop.
+    }
 
-    m_sceneManager->update(deltaTime);
+    {
+        TRACE_ZONE("Engine::update");
+        ProfileScope scope(m_profiler.get(), m_updateScope);
+        m_sceneManager->update(deltaTime);
+    }
+
+    if (m_inputManager->isActionJustPressed("toggle_trace_capture")) {
+        toggleTraceCapture();
+    }
+
+    // The tick has seen this frame's input, roll the "just pressed/released" state over.
+    // Doing it here rather than when polling events means an edge is never lost on a frame
+    // that runs no tick, nor seen twice on a frame that runs several.
+    m_inputManager->prepareForUpdate();
 }
 
 void Engine::render() {
-    SDL_SetRenderDrawColor(m_renderer.get(), 15, 15, 15, 255); // A dark grey background
-    SDL_RenderClear(m_renderer.get());
+    if (!m_renderer) return; // Headless without a renderer, nothing to draw into.
 
-    m_sceneManager->render();
+    {
+        TRACE_ZONE("Engine::render");
+        ProfileScope scope(m_profiler.get(), m_renderScope);
+        SDL_SetRenderDrawColor(m_renderer.get(), 15, 15, 15, 255); // A dark grey background
+        SDL_RenderClear(m_renderer.get());
+
+        m_sceneManager->render();
+    }
 
+    // With vsync on, this is mostly time spent waiting for the display.
+    TRACE_ZONE("Engine::present");
+    ProfileScope scope(m_profiler.get(), m_presentScope);
     SDL_RenderPresent(m_renderer.get());
 }
 
 void Engine::setupDefaultInputs() {
     // Keyboard
     m_inputManager->mapKeyToAction(SDLK_F1, "dump_debug_info");
+    m_inputManager->mapKeyToAction(SDLK_F2, "dump_profiler");
+    m_inputManager->mapKeyToAction(SDLK_F3, "toggle_trace_capture");
 
     m_inputManager->mapKeyToAction(SDLK_w, "move_up");
     m_inputManager->mapKeyToAction(SDLK_UP, "move_up");
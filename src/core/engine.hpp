@@ -5,15 +5,59 @@
 #include "../util/resource_manager.hpp"
 #include "scene_manager.hpp"
 #include "input_manager.hpp"
+#include "profiler.hpp"
+#include "job_system.hpp"
+#include "context.hpp"
 
 // Custom deleters for SDL resources to use with smart pointers
 struct SDL_Deleter {
     void operator()(SDL_Window* window) const { SDL_DestroyWindow(window); }
     void operator()(SDL_Renderer* renderer) const { SDL_DestroyRenderer(renderer); }
+    void operator()(SDL_Surface* surface) const { SDL_FreeSurface(surface); }
 };
 
 class Scene; // Forward-declaration
 
+/**
+ * @brief Where the engine renders to.
+ */
+enum class RenderBackend {
+    Window,   // A desktop window with an accelerated, vsynced renderer.
+    Software, // Headless: SDL's software renderer drawing into an offscreen surface.
+    None      // Headless: no renderer at all, render systems are skipped.
+};
+
+/**
+ * @struct EngineConfig
+ * @brief Start-up options for the Engine's main loop.
+ */
+struct EngineConfig {
+    // When true, update systems run at a fixed rate and render systems interpolate between ticks.
+    // When false, the simulation is stepped once per rendered frame with the measured delta time.
+    bool fixedTimestep = true;
+    int ticksPerSecond = 60;
+    // Upper bound of ticks simulated in a single frame. If a frame took longer than that,
+    // the remaining time is dropped: the game slows down instead of spiralling into ever longer frames.
+    int maxTicksPerFrame = 5;
+    // Start a timeline capture (see trace.hpp) before anything is loaded, so scene and
+    // asset loading show up in the trace. Stop it with the toggle_trace_capture action.
+    bool traceOnStartup = false;
+
+    RenderBackend renderBackend = RenderBackend::Window;
+    int screenWidth = DEFAULT_SCREEN_WIDTH;
+    int screenHeight = DEFAULT_SCREEN_HEIGHT;
+    // Quit after this many update ticks. 0 runs until the user quits.
+    // Headless backends ignore wall-clock time and run ticks back to back, so
+    // this is how a benchmark or soak test decides its length.
+    uint64_t maxTicks = 0;
+    // Worker threads of the engine's JobSystem, besides the main thread. Negative uses one per
+    // remaining hardware thread; 0 runs every job on the main thread.
+    int jobWorkerCount = -1;
+    // Print the profiler table when the main loop ends. Callers that report their own
+    // numbers from the profiler (e.g. the benchmark) leave it off.
+    bool dumpProfileOnExit = false;
+};
+
 class Engine {
 public:
     Engine();
@@ -23,24 +67,29 @@ public:
 
     void loadInputConfig();
 
-    bool init();
+    bool init(const EngineConfig& config = {});
     void run(const std::string& initialSceneId);
 
     [[nodiscard]]
     SDL_Renderer* getRenderer() const { return m_renderer.get(); }
     ResourceManager* getResourceManager() { return m_resourceManager.get(); }
     SceneManager* getSceneManager() { return m_sceneManager.get(); }
+    FrameProfiler* getProfiler() { return m_profiler.get(); }
+    JobSystem* getJobSystem() { return m_jobSystem.get(); }
 
     // This allows the user to add their own scenes
     void registerScene(const std::string& id, std::unique_ptr<Scene> scene);
 
 private:
     void handleEvents();
-    void update();
+    void update(float deltaTime);
     void render();
     void mainLoop();
     void setupDefaultInputs();
     void saveInputBindings();
+    bool initWindow();
+    bool initHeadless();
+    void toggleTraceCapture();
 
     // --- Member Declaration Order Matters for Destruction! ---
     // The C++ compiler will destruct these in reverse order of declaration.
@@ -48,19 +97,29 @@ private:
 
     // 1. Core SDL objects (destructed last)
     std::unique_ptr<SDL_Window, SDL_Deleter> m_window;
+    std::unique_ptr<SDL_Surface, SDL_Deleter> m_renderSurface; // Headless software rendering target.
     std::unique_ptr<SDL_Renderer, SDL_Deleter> m_renderer;
 
     // 2. Managers (depend on core SDL objects)
     std::unique_ptr<ResourceManager> m_resourceManager;
     std::unique_ptr<InputManager> m_inputManager;
+    std::unique_ptr<FrameProfiler> m_profiler;
+    std::unique_ptr<JobSystem> m_jobSystem; // Records into m_profiler.
 
     // 3. Scene Manager (depends on systems and managers, must be destructed first)
     std::unique_ptr<SceneManager> m_sceneManager;
 
     // --config variables --
     std::string m_userConfigPath;
+    EngineConfig m_config;
 
     // --- State Variables ---
     bool m_isRunning = false;
     uint64_t m_lastFrameTime = 0;
+    uint64_t m_tickCount = 0;
+
+    // --- Profiler scopes owned by the engine itself ---
+    FrameProfiler::ScopeId m_updateScope = 0;
+    FrameProfiler::ScopeId m_renderScope = 0;
+    FrameProfiler::ScopeId m_presentScope = 0;
 };
\ No newline at end of file
@@ -12,6 +12,7 @@ public:
 
     /**
      * @brief Called once when the state machine enters this state.
+     * Runs on one thread, after the parallel pass, so it may touch other entities too.
      * @param entity The entity that owns this state machine.
      * @param registry The scene's entity registry.
      */
@@ -19,6 +20,8 @@ public:
 
     /**
      * @brief Called every frame while this state is active.
+     * Usually runs in parallel with the states of other entities: it may only change this entity's
+     * existing components, never add or remove components or touch other entities.
      * @param entity The entity that owns this state machine.
      * @param registry The scene's entity registry.
      * @param deltaTime The time since the last frame.
@@ -27,6 +30,7 @@ public:
 
     /**
      * @brief Called once when the state machine exits this state.
+     * Runs on one thread, after the parallel pass, so it may touch other entities too.
      * @param entity The entity that owns this state machine.
      * @param registry The scene's entity registry.
      */
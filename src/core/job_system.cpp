@@ -0,0 +1,233 @@
+#include "job_system.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <string>
+
+namespace {
+    // Which job system, and which of its queues, the current thread works on.
+    thread_local const JobSystem* t_jobSystem = nullptr;
+    thread_local size_t t_queueIndex = 0;
+}
+
+// --- Queue ---
+
+void JobSystem::Queue::push(const Job& job, JobCounter* counter) {
+    if (count == ring.size()) {
+        // Grow and unwrap; only happens until the queue has seen its busiest frame.
+        std::vector<std::pair<Job, JobCounter*>> grown(std::max<size_t>(64, ring.size() * 2));
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = ring[(head + i) % ring.size()];
+        }
+        ring.swap(grown);
+        head = 0;
+    }
+    ring[(head + count) % ring.size()] = {job, counter};
+    ++count;
+}
+
+bool JobSystem::Queue::popNewest(std::pair<Job, JobCounter*>& job) {
+    if (count == 0) return false;
+    --count;
+    job = ring[(head + count) % ring.size()];
+    return true;
+}
+
+bool JobSystem::Queue::popOldest(std::pair<Job, JobCounter*>& job) {
+    if (count == 0) return false;
+    job = ring[head];
+    head = (head + 1) % ring.size();
+    --count;
+    return true;
+}
+
+// --- JobSystem ---
+
+JobSystem::JobSystem(int workerCount) {
+    if (workerCount < 0) {
+        workerCount = std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    for (int i = 0; i <= workerCount; ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::runWorker, this, static_cast<size_t>(i) + 1);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_isShuttingDown = true;
+    }
+    m_wakeUp.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+size_t JobSystem::getQueueIndex() const {
+    return t_jobSystem == this ? t_queueIndex : 0;
+}
+
+void JobSystem::runWorker(size_t queueIndex) {
+    t_jobSystem = this;
+    t_queueIndex = queueIndex;
+    Trace::setThreadName("JobWorker");
+
+    std::pair<Job, JobCounter*> job;
+    while (true) {
+        if (takeJob(queueIndex, job)) {
+            execute(job.first, *job.second);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeUp.wait(lock, [this] { return m_isShuttingDown || m_queuedJobCount.load() > 0; });
+        if (m_isShuttingDown) return;
+    }
+}
+
+void JobSystem::push(size_t queueIndex, const Job& job, JobCounter& counter) {
+    Queue& queue = *m_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.push(job, &counter);
+}
+
+void JobSystem::wakeWorkers(size_t jobCount) {
+    if (m_workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_queuedJobCount.fetch_add(static_cast<int64_t>(jobCount));
+    }
+    if (jobCount == 1) {
+        m_wakeUp.notify_one();
+    } else {
+        m_wakeUp.notify_all();
+    }
+}
+
+bool JobSystem::takeJob(size_t queueIndex, std::pair<Job, JobCounter*>& job) {
+    // Own queue first, newest job first: its data is most likely still in cache.
+    bool isFound = false;
+    {
+        Queue& queue = *m_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        isFound = queue.popNewest(job);
+    }
+    // Then steal the oldest job of the next queue that has one.
+    for (size_t i = 1; !isFound && i < m_queues.size(); ++i) {
+        Queue& queue = *m_queues[(queueIndex + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        isFound = queue.popOldest(job);
+    }
+    if (isFound && !m_workers.empty()) {
+        m_queuedJobCount.fetch_sub(1);
+    }
+    return isFound;
+}
+
+void JobSystem::execute(const Job& job, JobCounter& counter) {
+    const uint64_t start = m_profiler ? FrameProfiler::now() : 0;
+    {
+        TRACE_ZONE(job.name);
+        job.function(job.data, job.begin, job.end);
+    }
+    finish(counter, m_profiler ? FrameProfiler::now() - start : 0);
+}
+
+void JobSystem::finish(JobCounter& counter, uint64_t busyTicks) {
+    std::vector<std::pair<Job, JobCounter*>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+        counter.m_busyTicks.fetch_add(busyTicks, std::memory_order_relaxed);
+        if (counter.m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            continuations.swap(counter.m_continuations);
+        }
+    }
+    // Nothing may touch counter from here on: a waiter may already have returned.
+    const size_t queueIndex = getQueueIndex();
+    for (const auto& [job, jobCounter] : continuations) {
+        push(queueIndex, job, *jobCounter);
+    }
+    if (!continuations.empty()) {
+        wakeWorkers(continuations.size());
+    }
+}
+
+void JobSystem::schedule(const Job& job, JobCounter& counter) {
+    counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+    push(getQueueIndex(), job, counter);
+    wakeWorkers(1);
+}
+
+void JobSystem::scheduleAfter(JobCounter& dependency, const Job& job, JobCounter& counter) {
+    counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (!dependency.isDone()) {
+            // Queued by whichever job of dependency finishes last.
+            dependency.m_continuations.emplace_back(job, &counter);
+            return;
+        }
+    }
+    push(getQueueIndex(), job, counter);
+    wakeWorkers(1);
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    const size_t queueIndex = getQueueIndex();
+    std::pair<Job, JobCounter*> job;
+    while (!counter.isDone()) {
+        if (takeJob(queueIndex, job)) {
+            execute(job.first, *job.second);
+        } else {
+            // The last jobs are running elsewhere.
+            std::this_thread::yield();
+        }
+    }
+    // The last job may still be inside finish(); let it leave before the counter can go away.
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::run(const char* name, size_t count, size_t grainSize, Job::Function function, void* data) {
+    if (count == 0) return;
+    grainSize = std::max<size_t>(1, grainSize);
+    const bool isProfiled = m_profiler != nullptr;
+    const uint64_t start = isProfiled ? FrameProfiler::now() : 0;
+
+    JobCounter counter;
+    if (count <= grainSize || m_workers.empty()) {
+        // Nobody to share with: skip the queues.
+        counter.m_pending.store(1, std::memory_order_relaxed);
+        execute({name, function, data, 0, count}, counter);
+    } else {
+        // Deal the ranges out over all queues up front, so workers start without stealing.
+        const size_t jobCount = (count + grainSize - 1) / grainSize;
+        const size_t firstQueue = getQueueIndex();
+        counter.m_pending.store(static_cast<uint32_t>(jobCount), std::memory_order_relaxed);
+        for (size_t i = 0; i < jobCount; ++i) {
+            const size_t begin = i * grainSize;
+            push((firstQueue + i) % m_queues.size(), {name, function, data, begin, std::min(count, begin + grainSize)}, counter);
+        }
+        wakeWorkers(jobCount);
+        wait(counter);
+    }
+
+    if (isProfiled) {
+        const uint64_t end = FrameProfiler::now();
+        const ProfileScopes scopes = getProfileScopes(name);
+        m_profiler->record(scopes.wallScope, start, end);
+        m_profiler->record(scopes.workScope, 0, counter.m_busyTicks.load(std::memory_order_relaxed));
+    }
+}
+
+JobSystem::ProfileScopes JobSystem::getProfileScopes(const char* name) {
+    std::lock_guard<std::mutex> lock(m_profileScopesMutex);
+    // Names are string literals, so the pointer identifies the loop without string compares.
+    for (const auto& scopes : m_profileScopes) {
+        if (scopes.name == name) return scopes;
+    }
+    m_profileScopes.push_back({name,
+        m_profiler->registerScope(std::string("jobs/") + name),
+        m_profiler->registerScope(std::string("jobs/") + name + " (work)")});
+    return m_profileScopes.back();
+}
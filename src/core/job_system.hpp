@@ -0,0 +1,184 @@
+#pragma once
+
+#include "profiler.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * @struct Job
+ * @brief A unit of work: calls function(data, begin, end).
+ * The job does not own data; whoever schedules it keeps it alive until the job's counter is done.
+ */
+struct Job {
+    using Function = void (*)(void* data, size_t begin, size_t end);
+
+    const char* name = "Job"; // Timeline zone name; must be a string literal.
+    Function function = nullptr;
+    void* data = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+/**
+ * @class JobCounter
+ * @brief Counts the unfinished jobs scheduled with it. JobSystem::wait() on it returns once all
+ * of them are done, and JobSystem::scheduleAfter() holds jobs back until then.
+ * Must outlive every job scheduled with it, which waiting on it guarantees.
+ */
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    [[nodiscard]] bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> m_pending{0};
+    // Summed run time of its jobs in FrameProfiler::now() ticks, only measured while profiling.
+    std::atomic<uint64_t> m_busyTicks{0};
+    // Guards m_continuations and the final decrement, so a waiter never destroys it while a worker still uses it.
+    std::mutex m_mutex;
+    std::vector<std::pair<Job, JobCounter*>> m_continuations;
+};
+
+/**
+ * @class JobSystem
+ * @brief Engine-owned work-stealing scheduler with a fixed number of worker threads.
+ *
+ * Every worker has its own job deque: it runs its newest job first and, when it runs out, steals
+ * the oldest job of another queue. Threads outside the pool (e.g. the main loop) share one more
+ * queue, and instead of blocking in wait() they run jobs too, so with zero workers everything
+ * simply runs on the calling thread.
+ *
+ * Each job shows up as a zone in the timeline capture. parallelFor() also records two profiler
+ * scopes per name, from whichever thread calls it (e.g. a system running as a job): "jobs/<name>",
+ * the wall time of the whole loop, and "jobs/<name> (work)", the run time of its jobs summed over all threads.
+ */
+class JobSystem {
+public:
+    /**
+     * @param workerCount Threads besides the calling one; negative uses one per remaining hardware thread.
+     */
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * @brief Workers plus the thread that waits, i.e. how many jobs can run at the same time.
+     */
+    [[nodiscard]] unsigned getThreadCount() const { return static_cast<unsigned>(m_workers.size()) + 1; }
+
+    /**
+     * @brief Enables the "jobs/..." profiler scopes. The profiler is owned by the caller and is
+     * written to from the workers too. Pass nullptr to disable; not while jobs are running.
+     */
+    void setProfiler(FrameProfiler* profiler) {
+        std::lock_guard<std::mutex> lock(m_profileScopesMutex);
+        m_profiler = profiler;
+        m_profileScopes.clear();
+    }
+
+    /**
+     * @brief Queues a job; counter counts it until it has run.
+     */
+    void schedule(const Job& job, JobCounter& counter);
+
+    /**
+     * @brief Queues a job once every job of dependency is done; counter counts it from now on.
+     */
+    void scheduleAfter(JobCounter& dependency, const Job& job, JobCounter& counter);
+
+    /**
+     * @brief Runs queued jobs on the calling thread until every job of counter is done.
+     */
+    void wait(JobCounter& counter);
+
+    /**
+     * @brief Calls function(begin, end) over [0, count) split into ranges of grainSize, spread over
+     * all threads, and returns once every range is done. Ranges may run in any order and at the same
+     * time, so function must only write to state owned by its range.
+     * @param grainSize Indices per job: large enough to amortize scheduling, small enough to balance.
+     */
+    template <typename Function>
+    void parallelFor(const char* name, size_t count, size_t grainSize, Function&& function) {
+        using Callable = std::remove_reference_t<Function>;
+        run(name, count, grainSize, [](void* data, size_t begin, size_t end) {
+            (*static_cast<Callable*>(data))(begin, end);
+        }, const_cast<void*>(static_cast<const void*>(&function)));
+    }
+
+    /**
+     * @brief Calls function(element) for every element of a random access range, e.g. a std::vector
+     * of entities collected from a view. Same rules as parallelFor().
+     */
+    template <typename Range, typename Function>
+    void parallelForEach(const char* name, Range& range, size_t grainSize, Function&& function) {
+        auto first = range.begin();
+        parallelFor(name, static_cast<size_t>(range.end() - first), grainSize, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                function(first[i]);
+            }
+        });
+    }
+
+private:
+    /**
+     * @brief A job deque. A mutex per queue keeps it simple; jobs are coarse enough that it is never contended for long.
+     */
+    struct Queue {
+        std::mutex mutex;
+        std::vector<std::pair<Job, JobCounter*>> ring;
+        size_t head = 0;
+        size_t count = 0;
+
+        void push(const Job& job, JobCounter* counter);
+        bool popNewest(std::pair<Job, JobCounter*>& job);
+        bool popOldest(std::pair<Job, JobCounter*>& job);
+    };
+
+    struct ProfileScopes {
+        const char* name;
+        FrameProfiler::ScopeId wallScope;
+        FrameProfiler::ScopeId workScope;
+    };
+
+    // Queue 0 is shared by threads outside the pool, queue i + 1 belongs to worker i.
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_workers;
+    // Wakes idle workers; m_queuedJobCount only grows under m_sleepMutex so no wake-up is lost.
+    // Signed: a job may be taken before the push that queued it has been counted.
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUp;
+    std::atomic<int64_t> m_queuedJobCount{0};
+    bool m_isShuttingDown = false;
+
+    FrameProfiler* m_profiler = nullptr;
+    // Guards m_profileScopes: loops with a new name may start on several threads at once.
+    std::mutex m_profileScopesMutex;
+    std::vector<ProfileScopes> m_profileScopes;
+
+    void run(const char* name, size_t count, size_t grainSize, Job::Function function, void* data);
+    void runWorker(size_t queueIndex);
+    size_t getQueueIndex() const;
+
+    void push(size_t queueIndex, const Job& job, JobCounter& counter);
+    void wakeWorkers(size_t jobCount);
+    bool takeJob(size_t queueIndex, std::pair<Job, JobCounter*>& job);
+    void execute(const Job& job, JobCounter& counter);
+    void finish(JobCounter& counter, uint64_t busyTicks);
+    ProfileScopes getProfileScopes(const char* name);
+};
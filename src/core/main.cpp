@@ -1,20 +1,10 @@
 #include "engine.hpp"
 #include "system_manager.hpp"
 #include "../scenes/game_scene.hpp"
-#include "../systems/player_intent_system.hpp"
-#include "../systems/character_controller_system.hpp"
-#include "../systems/statemachine_system.hpp"
-#include "../systems/animation.hpp"
-#include "../systems/renderer.hpp"
-#include "../systems/debug_render_system.hpp"
-#include "../systems/tilemap_render_system.hpp"
-#include "../systems/camera_system.hpp"
-#include "../systems/debug_info_system.hpp"
-#include "../systems/collision_system.hpp"
-#include "../systems/physics_system.hpp"
-#include "../systems/behavior_system.hpp"
-#include "../systems/character_controller_system.hpp"
+#include "system_pipeline.hpp"
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
 #if WITH_FILE_LOADERS
     #include "../util/toml_scene_loader.hpp"
@@ -23,8 +13,28 @@
 #endif
 
 int main(int argc, char* argv[]) {
+    EngineConfig config;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--trace") {
+            config.traceOnStartup = true;
+        } else if (arg == "--headless") {
+            // No window and no renderer: measures update systems only.
+            config.renderBackend = RenderBackend::None;
+            config.dumpProfileOnExit = true;
+        } else if (arg == "--software-renderer") {
+            // No window, render systems draw with SDL's software backend.
+            config.renderBackend = RenderBackend::Software;
+            config.dumpProfileOnExit = true;
+        } else if (arg == "--ticks" && i + 1 < argc) {
+            config.maxTicks = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            std::cerr << "Ignoring unknown argument '" << arg << "'. Usage: game [--headless | --software-renderer] [--ticks N] [--trace]" << std::endl;
+        }
+    }
+
     Engine engine;
-    if (!engine.init()) {
+    if (!engine.init(config)) {
         return 1;
     }
 
@@ -47,26 +57,13 @@ int main(int argc, char* argv[]) {
 
     // 2. Create and configure the SystemManager (The "Assembler" part)
     auto systemManager = std::make_unique<SystemManager>();
+    systemManager->setProfiler(engine.getProfiler());
+    systemManager->setJobSystem(engine.getJobSystem());
     // Define the world boundaries for the Quadtree.
     // For now, we'll hardcode it. Later, this could come from the scene file.
     //TODO: this data must come from the scene file or at least the map file. MAy from both! This is a discussion topic.
     QuadtreeRect worldBounds = {0, 0, 1280, 720};
-    // ---- THE CORRECT PHYSICS LOOP ORDER ----
-    systemManager->addUpdateSystem(std::make_unique<PlayerIntentSystem>());
-    systemManager->addUpdateSystem(std::make_unique<CharacterControllerSystem>());
-    systemManager->addUpdateSystem(std::make_unique<PhysicsSystem>());
-    systemManager->addUpdateSystem(std::make_unique<CollisionSystem>(worldBounds));
-    systemManager->addUpdateSystem(std::make_unique<BehaviorSystem>());
-    // ------------------------------------------
-    systemManager->addUpdateSystem(std::make_unique<StateMachineSystem>());
-    systemManager->addUpdateSystem(std::make_unique<AnimationSystem>());
-    systemManager->addUpdateSystem(std::make_unique<CameraSystem>());
-    systemManager->addUpdateSystem(std::make_unique<DebugInfoSystem>());
-
-    // The order we add render systems determines the draw order (background first)
-    systemManager->addRenderSystem(std::make_unique<TilemapRenderSystem>());
-    systemManager->addRenderSystem(std::make_unique<RenderSystem>());
-    systemManager->addRenderSystem(std::make_unique<DebugRenderSystem>());
+    addDefaultSystems(*systemManager, worldBounds);
 
     // 3. Inject the configured manager into the scene.
     gameScene->setSystemManager(std::move(systemManager));
@@ -0,0 +1,95 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <iomanip>
+
+FrameProfiler::ScopeId FrameProfiler::registerScope(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (ScopeId id = 0; id < m_scopes.size(); ++id) {
+        if (m_scopes[id].name == name) return id;
+    }
+    Scope scope;
+    scope.name = name;
+    scope.samples.resize(WINDOW_SIZE, 0.0);
+    m_scopes.push_back(std::move(scope));
+    return m_scopes.size() - 1;
+}
+
+void FrameProfiler::record(ScopeId id, uint64_t startCounter, uint64_t endCounter) {
+    static const double ticksToMs = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (id >= m_scopes.size()) return;
+    auto& scope = m_scopes[id];
+    scope.samples[scope.next] = static_cast<double>(endCounter - startCounter) * ticksToMs;
+    scope.next = (scope.next + 1) % WINDOW_SIZE;
+    scope.count = std::min(scope.count + 1, WINDOW_SIZE);
+}
+
+ProfileStats FrameProfiler::getStats(ScopeId id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return getStatsLocked(id);
+}
+
+ProfileStats FrameProfiler::getStatsLocked(ScopeId id) const {
+    ProfileStats stats;
+    if (id >= m_scopes.size()) return stats;
+
+    const auto& scope = m_scopes[id];
+    stats.name = scope.name;
+    stats.sampleCount = scope.count;
+    if (scope.count == 0) return stats;
+
+    // Only the first `count` slots are valid until the ring has wrapped once.
+    std::vector<double> sorted(scope.samples.begin(), scope.samples.begin() + scope.count);
+    std::sort(sorted.begin(), sorted.end());
+
+    double total = 0.0;
+    for (double sample : sorted) total += sample;
+
+    stats.minMs = sorted.front();
+    stats.maxMs = sorted.back();
+    stats.avgMs = total / static_cast<double>(sorted.size());
+    // Nearest-rank percentile.
+    const size_t p99Index = (sorted.size() * 99 + 99) / 100 - 1;
+    stats.p99Ms = sorted[std::min(p99Index, sorted.size() - 1)];
+    return stats;
+}
+
+std::vector<ProfileStats> FrameProfiler::getAllStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<ProfileStats> result;
+    result.reserve(m_scopes.size());
+    for (ScopeId id = 0; id < m_scopes.size(); ++id) {
+        result.push_back(getStatsLocked(id));
+    }
+    return result;
+}
+
+void FrameProfiler::dump(std::ostream& out) const {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+
+    out << "\n\n==================== PROFILER (last " << WINDOW_SIZE << " samples, ms) ====================" << std::endl;
+    out << std::left << std::setw(32) << "Scope"
+        << std::right << std::setw(9) << "min" << std::setw(9) << "avg"
+        << std::setw(9) << "max" << std::setw(9) << "p99" << std::setw(9) << "samples" << std::endl;
+    out << std::fixed << std::setprecision(3);
+    for (const auto& stats : getAllStats()) {
+        out << std::left << std::setw(32) << stats.name
+            << std::right << std::setw(9) << stats.minMs << std::setw(9) << stats.avgMs
+            << std::setw(9) << stats.maxMs << std::setw(9) << stats.p99Ms
+            << std::setw(9) << stats.sampleCount << std::endl;
+    }
+    out << "====================================================\n\n" << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void FrameProfiler::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& scope : m_scopes) {
+        scope.next = 0;
+        scope.count = 0;
+    }
+}
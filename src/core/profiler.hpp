@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <SDL2/SDL.h>
+
+/**
+ * @struct ProfileStats
+ * @brief Timing summary of one profiled scope over the profiler's rolling window.
+ */
+struct ProfileStats {
+    std::string name;
+    double minMs = 0.0;
+    double avgMs = 0.0;
+    double maxMs = 0.0;
+    double p99Ms = 0.0;
+    size_t sampleCount = 0;
+};
+
+/**
+ * @class FrameProfiler
+ * @brief Collects CPU timings of named scopes (systems, dispatcher flush, present...)
+ * over the last WINDOW_SIZE samples of each scope.
+ *
+ * Scopes are registered once and then recorded by id, so recording a sample is a
+ * single write into a preallocated ring buffer. Every method may be called from any
+ * thread (jobs record from the workers); a mutex serializes them.
+ */
+class FrameProfiler {
+public:
+    using ScopeId = size_t;
+
+    // Number of samples kept per scope. At 60 ticks per second this is ~4 seconds.
+    static constexpr size_t WINDOW_SIZE = 240;
+
+    /**
+     * @brief Returns the id for a scope name, registering it on first use.
+     */
+    ScopeId registerScope(const std::string& name);
+
+    void record(ScopeId id, uint64_t startCounter, uint64_t endCounter);
+
+    [[nodiscard]] ProfileStats getStats(ScopeId id) const;
+    [[nodiscard]] std::vector<ProfileStats> getAllStats() const;
+
+    /**
+     * @brief Writes a table with the stats of every scope, in registration order.
+     */
+    void dump(std::ostream& out) const;
+
+    void reset();
+
+    [[nodiscard]] static uint64_t now() { return SDL_GetPerformanceCounter(); }
+
+private:
+    struct Scope {
+        std::string name;
+        std::vector<double> samples; // Ring buffer of durations in milliseconds.
+        size_t next = 0;
+        size_t count = 0;
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<Scope> m_scopes;
+
+    [[nodiscard]] ProfileStats getStatsLocked(ScopeId id) const;
+};
+
+/**
+ * @class ProfileScope
+ * @brief RAII helper that records the time between its construction and destruction.
+ * Does nothing when given a null profiler.
+ */
+class ProfileScope {
+public:
+    ProfileScope(FrameProfiler* profiler, FrameProfiler::ScopeId id)
+        : m_profiler(profiler), m_id(id), m_start(profiler ? FrameProfiler::now() : 0) {}
+    ~ProfileScope() {
+        if (m_profiler) m_profiler->record(m_id, m_start, FrameProfiler::now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    FrameProfiler* m_profiler;
+    FrameProfiler::ScopeId m_id;
+    uint64_t m_start;
+};
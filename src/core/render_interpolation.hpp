@@ -0,0 +1,30 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include "context.hpp"
+#include "../components/transform.hpp"
+
+/**
+ * @brief Returns the blend factor between the previous and the latest simulation tick.
+ */
+inline float getRenderInterpolationAlpha(const entt::registry& registry) {
+    return registry.ctx().contains<RenderInterpolation>()
+        ? registry.ctx().get<RenderInterpolation>().alpha
+        : 1.0f;
+}
+
+/**
+ * @brief Returns the position an entity should be drawn at for the current frame.
+ * Entities without a PreviousTransformComponent are drawn at their latest position.
+ */
+inline Vec2f getInterpolatedPosition(const entt::registry& registry, entt::entity entity,
+        const TransformComponent& transform, float alpha) {
+    const auto* previous = registry.try_get<PreviousTransformComponent>(entity);
+    if (!previous || alpha >= 1.0f) {
+        return transform.position;
+    }
+    return {
+        previous->position.x + (transform.position.x - previous->position.x) * alpha,
+        previous->position.y + (transform.position.y - previous->position.y) * alpha
+    };
+}
@@ -28,6 +28,14 @@ public:
     // Called every frame for game logic updates.
     virtual void update(float deltaTime) = 0;
 
+    // Called every frame before render() with how far (0..1) the frame is between
+    // the previous and the latest update tick. Scenes that interpolate drawing use it.
+    virtual void setInterpolationAlpha(float alpha) {}
+
+    // Called when the renderer lost the contents of every target texture, e.g. on
+    // SDL_RENDER_TARGETS_RESET or SDL_RENDER_DEVICE_RESET. Scenes drop whatever they cached in them.
+    virtual void onRenderTargetsReset() {}
+
     // Called every frame to draw the scene.
     virtual void render(SDL_Renderer* renderer) = 0;
 };
@@ -1,4 +1,5 @@
 #include "scene_manager.hpp"
+#include "trace.hpp"
 #include <iostream>
 
 SceneManager::SceneManager(SDL_Renderer* renderer, ResourceManager* resourceManager,
@@ -15,6 +16,7 @@ void SceneManager::registerScene(const std::string& id, std::unique_ptr<Scene> s
 }
 
 void SceneManager::switchTo(const std::string& id) {
+    TRACE_ZONE("SceneManager::switchTo");
     auto it = m_scenes.find(id);
     if (it == m_scenes.end()) {
         std::cerr << "SceneManager: No scene registered with ID '" << id << "'." << std::endl;
@@ -47,12 +49,24 @@ void SceneManager::update(float deltaTime) {
     }
 }
 
+void SceneManager::setInterpolationAlpha(float alpha) {
+    if (!m_currentSceneId.empty()) {
+        m_scenes[m_currentSceneId]->setInterpolationAlpha(alpha);
+    }
+}
+
 void SceneManager::render() {
     if (!m_currentSceneId.empty()) {
         m_scenes[m_currentSceneId]->render(m_renderer);
     }
 }
 
+void SceneManager::onRenderTargetsReset() {
+    for (auto& [id, scene] : m_scenes) {
+        scene->onRenderTargetsReset();
+    }
+}
+
 void SceneManager::shutdown() {
     if (!m_currentSceneId.empty() && m_scenes.count(m_currentSceneId)) {
         m_scenes[m_currentSceneId]->unload();
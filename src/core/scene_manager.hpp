@@ -35,8 +35,14 @@ public:
     // --- Engine Call Delegation ---
     void handleEvents(const SDL_Event& event);
     void update(float deltaTime);
+    void setInterpolationAlpha(float alpha);
     void render();
 
+    /**
+     * @brief Forwards a render target or device reset to every registered scene, loaded or not.
+     */
+    void onRenderTargetsReset();
+
     /**
      * @brief Unloads the current scene. Called before the engine shuts down.
      */
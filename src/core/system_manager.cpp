@@ -1,33 +1,161 @@
 #include "system_manager.hpp"
+#include "trace.hpp"
+#include <string>
 
 void SystemManager::addUpdateSystem(std::unique_ptr<IUpdateSystem> system) {
     m_updateSystems.push_back(std::move(system));
+    m_isUpdateGraphDirty = true;
+    registerProfileScopes();
 }
 
 void SystemManager::addRenderSystem(std::unique_ptr<IRenderSystem> system) {
     m_renderSystems.push_back(std::move(system));
+    registerProfileScopes();
+}
+
+void SystemManager::setProfiler(FrameProfiler* profiler) {
+    m_profiler = profiler;
+    registerProfileScopes();
+}
+
+void SystemManager::registerProfileScopes() {
+    m_updateScopes.clear();
+    m_renderScopes.clear();
+    if (!m_profiler) return;
+
+    for (const auto& system : m_updateSystems) {
+        m_updateScopes.push_back(m_profiler->registerScope(std::string("update/") + system->getName()));
+    }
+    m_dispatcherScope = m_profiler->registerScope("update/dispatcher");
+    for (const auto& system : m_renderSystems) {
+        m_renderScopes.push_back(m_profiler->registerScope(std::string("draw/") + system->getName()));
+    }
 }
 
 void SystemManager::initAll(entt::registry& registry) {
+    TRACE_ZONE("SystemManager::initAll");
+    // Make the profiler reachable from systems (e.g. for the debug dump).
+    if (m_profiler) {
+        registry.ctx().emplace<FrameProfiler*>(m_profiler);
+    }
+    if (m_jobSystem) {
+        registry.ctx().emplace<JobSystem*>(m_jobSystem);
+    }
+
     for (auto& system : m_updateSystems) {
         system->init(registry);
     }
     for (auto& system : m_renderSystems) {
         system->init(registry);
     }
+    buildUpdateGraph(registry);
+}
+
+void SystemManager::buildUpdateGraph(entt::registry& registry) {
+    const size_t count = m_updateSystems.size();
+    std::vector<SystemAccess> accesses;
+    accesses.reserve(count);
+    for (const auto& system : m_updateSystems) {
+        accesses.push_back(system->getAccess());
+        accesses.back().createStorages(registry);
+    }
+
+    // A system depends on every earlier system it conflicts with, which keeps the declared order
+    // between conflicting systems and lets the others overlap.
+    m_updateNodes.assign(count, UpdateNode{});
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            if (accesses[j].conflictsWith(accesses[i])) {
+                m_updateNodes[j].dependents.push_back(i);
+                ++m_updateNodes[i].dependencyCount;
+            }
+        }
+    }
+    m_pendingDependencies = std::vector<std::atomic<size_t>>(count);
+    m_isUpdateGraphDirty = false;
 }
 
 void SystemManager::updateAll(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager, float deltaTime) {
-    for (auto& system : m_updateSystems) {
-        system->update(registry, inputManager, resourceManager, deltaTime);
+    if (m_jobSystem && m_jobSystem->getThreadCount() > 1) {
+        updateConcurrently(registry, inputManager, resourceManager, deltaTime);
+    } else {
+        updateSequentially(registry, inputManager, resourceManager, deltaTime);
     }
 
     // Process all enqueued events and notify listeners.
+    TRACE_ZONE("entt::dispatcher::update");
+    ProfileScope scope(m_profiler, m_dispatcherScope);
     registry.ctx().get<entt::dispatcher>().update();
 }
 
-void SystemManager::drawAll(SDL_Renderer* renderer, entt::registry& registry, ResourceManager& resourceManager) {
+void SystemManager::updateSequentially(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager, float deltaTime) {
+    for (size_t i = 0; i < m_updateSystems.size(); ++i) {
+        TRACE_ZONE(m_updateSystems[i]->getName());
+        ProfileScope scope(m_profiler, m_profiler ? m_updateScopes[i] : 0);
+        m_updateSystems[i]->update(registry, inputManager, resourceManager, deltaTime);
+    }
+}
+
+void SystemManager::updateConcurrently(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager, float deltaTime) {
+    if (m_isUpdateGraphDirty) {
+        buildUpdateGraph(registry);
+    }
+
+    JobCounter tickCounter;
+    m_tickArguments = {&registry, &inputManager, &resourceManager, deltaTime};
+    m_tickCounter = &tickCounter;
+    for (size_t i = 0; i < m_updateNodes.size(); ++i) {
+        m_pendingDependencies[i].store(m_updateNodes[i].dependencyCount, std::memory_order_relaxed);
+    }
+    // Systems that wait for nobody start right away; each finished system starts the ones it unblocks.
+    for (size_t i = 0; i < m_updateNodes.size(); ++i) {
+        if (m_updateNodes[i].dependencyCount == 0) {
+            scheduleUpdateSystem(i);
+        }
+    }
+    m_jobSystem->wait(tickCounter);
+    m_tickCounter = nullptr;
+
+    // Recorded once the tick is over rather than from each job, so the systems never wait on the profiler lock.
+    if (m_profiler) {
+        for (size_t i = 0; i < m_updateNodes.size(); ++i) {
+            m_profiler->record(m_updateScopes[i], m_updateNodes[i].startCounter, m_updateNodes[i].endCounter);
+        }
+    }
+}
+
+void SystemManager::scheduleUpdateSystem(size_t index) {
+    // The job's range is just the system index. Its name becomes the system's zone in the timeline.
+    m_jobSystem->schedule({m_updateSystems[index]->getName(), &SystemManager::runUpdateSystemJob, this, index, index + 1},
+        *m_tickCounter);
+}
+
+void SystemManager::runUpdateSystemJob(void* data, size_t index, size_t) {
+    auto& self = *static_cast<SystemManager*>(data);
+    const TickArguments& arguments = self.m_tickArguments;
+    UpdateNode& node = self.m_updateNodes[index];
+
+    node.startCounter = FrameProfiler::now();
+    self.m_updateSystems[index]->update(*arguments.registry, *arguments.inputManager, *arguments.resourceManager, arguments.deltaTime);
+    node.endCounter = FrameProfiler::now();
+
+    for (const size_t dependent : node.dependents) {
+        if (self.m_pendingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            self.scheduleUpdateSystem(dependent);
+        }
+    }
+}
+
+void SystemManager::onRenderTargetsReset() {
     for (auto& system : m_renderSystems) {
-        system->draw(renderer, registry, resourceManager);
+        system->onRenderTargetsReset();
+    }
+}
+
+void SystemManager::drawAll(SDL_Renderer* renderer, entt::registry& registry, ResourceManager& resourceManager) {
+    for (size_t i = 0; i < m_renderSystems.size(); ++i) {
+        TRACE_ZONE(m_renderSystems[i]->getName());
+        ProfileScope scope(m_profiler, m_profiler ? m_renderScopes[i] : 0);
+        m_renderSystems[i]->draw(renderer, registry, resourceManager);
     }
 }
@@ -1,19 +1,90 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include "systems/isystem.hpp"
+#include "profiler.hpp"
+#include "job_system.hpp"
 
+/**
+ * @class SystemManager
+ * @brief Owns a scene's systems and runs them every tick.
+ *
+ * Update systems run in the order they were added, except that with a JobSystem, systems whose
+ * declared SystemAccess doesn't conflict run at the same time. Each system waits for every
+ * earlier system it conflicts with, so the result is the same as running them one by one.
+ */
 class SystemManager {
 public:
     void addUpdateSystem(std::unique_ptr<IUpdateSystem> system);
     void addRenderSystem(std::unique_ptr<IRenderSystem> system);
 
+    /**
+     * @brief Enables per-system timing. The profiler is owned by the caller (the Engine)
+     * and must outlive this manager. Pass nullptr to disable.
+     */
+    void setProfiler(FrameProfiler* profiler);
+
+    /**
+     * @brief Makes the engine's JobSystem available to systems through the registry context, as a
+     * JobSystem* they can pick up in init(), and runs non-conflicting update systems on it.
+     * Owned by the caller; nullptr runs everything on the calling thread.
+     */
+    void setJobSystem(JobSystem* jobSystem) { m_jobSystem = jobSystem; }
+
     void initAll(entt::registry& registry);
     void updateAll(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager, float deltaTime);
     void drawAll(SDL_Renderer* renderer, entt::registry& registry, ResourceManager& resourceManager);
 
+    /**
+     * @brief Tells every render system that target textures lost their contents.
+     */
+    void onRenderTargetsReset();
+
 private:
+    /**
+     * @brief An update system in the dependency graph. dependencyCount counts the earlier systems
+     * it conflicts with; dependents are the later systems that conflict with it.
+     */
+    struct UpdateNode {
+        std::vector<size_t> dependents;
+        size_t dependencyCount = 0;
+        uint64_t startCounter = 0;
+        uint64_t endCounter = 0;
+    };
+
+    // What the jobs of the tick being run need to call update().
+    struct TickArguments {
+        entt::registry* registry = nullptr;
+        InputManager* inputManager = nullptr;
+        ResourceManager* resourceManager = nullptr;
+        float deltaTime = 0.0f;
+    };
+
+    void registerProfileScopes();
+    void buildUpdateGraph(entt::registry& registry);
+    void updateSequentially(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager, float deltaTime);
+    void updateConcurrently(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager, float deltaTime);
+    void scheduleUpdateSystem(size_t index);
+    static void runUpdateSystemJob(void* data, size_t index, size_t);
+
     std::vector<std::unique_ptr<IUpdateSystem>> m_updateSystems;
     std::vector<std::unique_ptr<IRenderSystem>> m_renderSystems;
+
+    // --- Concurrent updates ---
+    JobSystem* m_jobSystem = nullptr;
+    // Parallel to m_updateSystems; rebuilt when a system is added.
+    std::vector<UpdateNode> m_updateNodes;
+    std::vector<std::atomic<size_t>> m_pendingDependencies;
+    bool m_isUpdateGraphDirty = true;
+    TickArguments m_tickArguments;
+    JobCounter* m_tickCounter = nullptr;
+
+    // --- Profiling ---
+    FrameProfiler* m_profiler = nullptr;
+    // Scope ids, parallel to m_updateSystems / m_renderSystems.
+    std::vector<FrameProfiler::ScopeId> m_updateScopes;
+    std::vector<FrameProfiler::ScopeId> m_renderScopes;
+    FrameProfiler::ScopeId m_dispatcherScope = 0;
 };
@@ -0,0 +1,38 @@
+#include "system_pipeline.hpp"
+#include "../systems/player_intent_system.hpp"
+#include "../systems/character_controller_system.hpp"
+#include "../systems/statemachine_system.hpp"
+#include "../systems/animation.hpp"
+#include "../systems/renderer.hpp"
+#include "../systems/debug_render_system.hpp"
+#include "../systems/tilemap_render_system.hpp"
+#include "../systems/camera_system.hpp"
+#include "../systems/debug_info_system.hpp"
+#include "../systems/collision_system.hpp"
+#include "../systems/physics_system.hpp"
+#include "../systems/behavior_system.hpp"
+#include "../systems/transform_history_system.hpp"
+
+void addDefaultSystems(SystemManager& systemManager, const QuadtreeRect& worldBounds, BroadPhaseType broadPhaseType,
+                       unsigned collisionThreadCount) {
+    // Must run first: snapshots positions before this tick moves anything.
+    systemManager.addUpdateSystem(std::make_unique<TransformHistorySystem>());
+    // ---- THE CORRECT PHYSICS LOOP ORDER ----
+    systemManager.addUpdateSystem(std::make_unique<PlayerIntentSystem>());
+    systemManager.addUpdateSystem(std::make_unique<CharacterControllerSystem>());
+    systemManager.addUpdateSystem(std::make_unique<PhysicsSystem>());
+    auto collisionSystem = std::make_unique<CollisionSystem>(worldBounds, broadPhaseType);
+    collisionSystem->setDetectionThreadCount(collisionThreadCount);
+    systemManager.addUpdateSystem(std::move(collisionSystem));
+    systemManager.addUpdateSystem(std::make_unique<BehaviorSystem>());
+    // ------------------------------------------
+    systemManager.addUpdateSystem(std::make_unique<StateMachineSystem>());
+    systemManager.addUpdateSystem(std::make_unique<AnimationSystem>());
+    systemManager.addUpdateSystem(std::make_unique<CameraSystem>());
+    systemManager.addUpdateSystem(std::make_unique<DebugInfoSystem>());
+
+    // The order we add render systems determines the draw order (background first)
+    systemManager.addRenderSystem(std::make_unique<TilemapRenderSystem>());
+    systemManager.addRenderSystem(std::make_unique<RenderSystem>());
+    systemManager.addRenderSystem(std::make_unique<DebugRenderSystem>());
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "system_manager.hpp"
+#include "../util/broad_phase.hpp" // For QuadtreeRect, BroadPhaseType
+
+/**
+ * @brief Adds the game's standard update and render systems to a SystemManager, in order.
+ *
+ * Shared by the game executable and the benchmark so both always run the same pipeline.
+ * @param systemManager The manager to populate. Systems already in it run before these.
+ * @param worldBounds The area covered by the collision broad phase.
+ * @param broadPhaseType Which broad phase the CollisionSystem uses.
+ * @param collisionThreadCount Threads the CollisionSystem may use for contact detection; 0 uses every JobSystem thread.
+ */
+void addDefaultSystems(SystemManager& systemManager, const QuadtreeRect& worldBounds,
+    BroadPhaseType broadPhaseType = BroadPhaseType::LinearQuadtree, unsigned collisionThreadCount = 0);
@@ -2,11 +2,94 @@
 
 #include <entt/entt.hpp>
 #include <SDL2/SDL.h>
+#include <algorithm>
+#include <vector>
 
 // Forward-declare to avoid including heavy headers in the interface
 class ResourceManager;
 class InputManager;
 
+/**
+ * @class SystemAccess
+ * @brief What an update system touches each tick, so the SystemManager can run systems that
+ * don't conflict at the same time.
+ *
+ * Components are the ones reached through the registry; emplacing, removing or patching a
+ * component counts as writing it. Resources are shared objects outside the registry, such as
+ * the entt::dispatcher or the InputManager. Two systems conflict if either writes something
+ * the other reads or writes. A system that creates or destroys entities, or that can't tell
+ * what it touches, must be exclusive: it then runs alone.
+ */
+class SystemAccess {
+public:
+    static SystemAccess exclusive() {
+        SystemAccess access;
+        access.m_isExclusive = true;
+        return access;
+    }
+
+    template <typename... Components>
+    SystemAccess& read() {
+        (addComponent<Components>(m_reads), ...);
+        return *this;
+    }
+
+    template <typename... Components>
+    SystemAccess& write() {
+        (addComponent<Components>(m_writes), ...);
+        return *this;
+    }
+
+    template <typename... Resources>
+    SystemAccess& readResource() {
+        (m_reads.push_back(entt::type_hash<Resources>::value()), ...);
+        return *this;
+    }
+
+    template <typename... Resources>
+    SystemAccess& writeResource() {
+        (m_writes.push_back(entt::type_hash<Resources>::value()), ...);
+        return *this;
+    }
+
+    [[nodiscard]] bool isExclusive() const { return m_isExclusive; }
+
+    [[nodiscard]] bool conflictsWith(const SystemAccess& other) const {
+        return m_isExclusive || other.m_isExclusive
+            || overlaps(m_writes, other.m_reads) || overlaps(m_writes, other.m_writes)
+            || overlaps(other.m_writes, m_reads);
+    }
+
+    /**
+     * @brief Creates the storage of every declared component that doesn't have one yet. The registry
+     * creates storages on first use, which is not safe while other systems use it from other threads.
+     */
+    void createStorages(entt::registry& registry) const {
+        for (const auto createStorage : m_storageCreators) {
+            createStorage(registry);
+        }
+    }
+
+private:
+    bool m_isExclusive = false;
+    std::vector<entt::id_type> m_reads;
+    std::vector<entt::id_type> m_writes;
+    std::vector<void (*)(entt::registry&)> m_storageCreators;
+
+    template <typename Component>
+    void addComponent(std::vector<entt::id_type>& ids) {
+        ids.push_back(entt::type_hash<Component>::value());
+        m_storageCreators.push_back([](entt::registry& registry) { registry.storage<Component>(); });
+    }
+
+    static bool overlaps(const std::vector<entt::id_type>& a, const std::vector<entt::id_type>& b) {
+        for (const auto id : a) {
+            if (std::find(b.begin(), b.end(), id) != b.end()) return true;
+        }
+        return false;
+    }
+};
+
 /**
  * @brief Base interface for any system that runs logic in the main update loop.
  */
@@ -14,6 +97,14 @@ class IUpdateSystem {
 public:
     virtual ~IUpdateSystem() = default;
     virtual void init(entt::registry& registry) {}
+    // Human readable name, used by the profiler.
+    virtual const char* getName() const { return "UnnamedUpdateSystem"; }
+
+    /**
+     * @brief The components and resources update() touches. Systems that don't declare it are
+     * exclusive and never run alongside another system.
+     */
+    virtual SystemAccess getAccess() const { return SystemAccess::exclusive(); }
     virtual void update(entt::registry& registry, InputManager& inputManager,
         ResourceManager& resourceManager, float deltaTime) = 0;
 };
@@ -25,6 +116,11 @@ class IRenderSystem {
 public:
     virtual ~IRenderSystem() = default;
     virtual void init(entt::registry& registry) {}
+    // Human readable name, used by the profiler.
+    virtual const char* getName() const { return "UnnamedRenderSystem"; }
+    // Called when the renderer lost the contents of every target texture (device or target reset);
+    // systems that cache drawing in target textures must redraw them.
+    virtual void onRenderTargetsReset() {}
     virtual void draw(SDL_Renderer* renderer, entt::registry& registry,
         ResourceManager& resourceManager) = 0;
 };
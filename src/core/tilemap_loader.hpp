@@ -1,11 +1,36 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <entt/entt.hpp>
 
 // Forward-declarations
 class ResourceManager;
 
+/**
+ * @enum TileCollisionMode
+ * @brief How a map's walls become collision geometry.
+ */
+enum class TileCollisionMode {
+    Objects,  // One static collider entity per rectangle in the "Collisions" object layer.
+    TileGrid  // A TileCollisionGridComponent built from tiles flagged solid; no wall entities.
+};
+
+/**
+ * @struct TilemapLoadOptions
+ * @brief Per-map settings shared by all tilemap loaders.
+ */
+struct TilemapLoadOptions {
+    TileCollisionMode collisionMode = TileCollisionMode::Objects;
+    // Boolean tile property that marks a tile as solid in TileGrid mode.
+    std::string solidPropertyName = "solid";
+    // Physics layer/mask given to solid tiles in TileGrid mode (defaults: WORLD, WORLD|PLAYER).
+    uint32_t solidLayer = 1 << 0;
+    uint32_t solidMask = (1 << 0) | (1 << 1);
+    // Objects mode: merge adjacent/overlapping static wall rects with the same layer/mask at load time.
+    bool mergeCollisionRects = false;
+};
+
 /**
  * @class ITilemapLoader
  * @brief An interface for classes that load tilemap data into an entity.
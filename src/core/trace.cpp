@@ -0,0 +1,149 @@
+#include "trace.hpp"
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trace {
+namespace detail {
+
+std::atomic<bool> g_isCapturing{false};
+
+namespace {
+    struct Event {
+        const char* name;
+        uint64_t startNs;
+        uint64_t endNs;
+    };
+
+    // Per-thread ring, ~1.5 MB. Holds a few seconds of a heavily instrumented frame loop.
+    constexpr size_t RING_CAPACITY = 1 << 16;
+
+    /**
+     * Single-producer ring: only the owning thread writes events and advances `written`.
+     * The exporter reads it after capture has been stopped.
+     */
+    struct ThreadBuffer {
+        std::array<Event, RING_CAPACITY> events;
+        std::atomic<uint64_t> written{0};
+        uint32_t threadId = 0;
+        std::string threadName;
+    };
+
+    // Every buffer ever created. Buffers are never freed while the program runs, so a
+    // thread that exits leaves its events readable for the exporter.
+    std::mutex g_buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> g_buffers;
+
+    std::atomic<uint64_t> g_captureStartNs{0};
+
+    ThreadBuffer& getThreadBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            // First zone on this thread: register its buffer. This is the only lock on the path.
+            std::lock_guard<std::mutex> lock(g_buffersMutex);
+            g_buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = g_buffers.back().get();
+            buffer->threadId = static_cast<uint32_t>(g_buffers.size());
+        }
+        return *buffer;
+    }
+
+    void writeEscaped(std::ostream& out, const char* text) {
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') out << '\\';
+            out << *c;
+        }
+    }
+}
+
+uint64_t nowNanoseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void recordZone(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index % RING_CAPACITY] = Event{name, startNs, endNs};
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+} // namespace detail
+
+void beginCapture() {
+    {
+        std::lock_guard<std::mutex> lock(detail::g_buffersMutex);
+        for (auto& buffer : detail::g_buffers) {
+            buffer->written.store(0, std::memory_order_relaxed);
+        }
+    }
+    detail::g_captureStartNs.store(detail::nowNanoseconds(), std::memory_order_relaxed);
+    detail::g_isCapturing.store(true, std::memory_order_release);
+    std::cout << "Trace: Capture started." << std::endl;
+}
+
+bool endCapture(const std::string& filepath) {
+    if (!detail::g_isCapturing.exchange(false, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    std::ofstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Trace: Could not open file for writing: " << filepath << std::endl;
+        return false;
+    }
+
+    const uint64_t captureStartNs = detail::g_captureStartNs.load(std::memory_order_relaxed);
+    size_t eventCount = 0;
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    std::lock_guard<std::mutex> lock(detail::g_buffersMutex);
+    for (const auto& buffer : detail::g_buffers) {
+        const uint64_t written = buffer->written.load(std::memory_order_acquire);
+        if (written == 0) continue;
+
+        if (!buffer->threadName.empty()) {
+            file << (first ? "" : ",\n")
+                 << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                 << ",\"args\":{\"name\":\"";
+            detail::writeEscaped(file, buffer->threadName.c_str());
+            file << "\"}}";
+            first = false;
+        }
+
+        // If the ring wrapped, only the newest RING_CAPACITY events are still there.
+        const uint64_t begin = written > detail::RING_CAPACITY ? written - detail::RING_CAPACITY : 0;
+        for (uint64_t i = begin; i < written; ++i) {
+            const auto& event = buffer->events[i % detail::RING_CAPACITY];
+            if (event.startNs < captureStartNs) continue; // Zone opened before the capture started.
+
+            // Chrome expects microseconds.
+            file << (first ? "" : ",\n") << "{\"name\":\"";
+            detail::writeEscaped(file, event.name);
+            file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                 << ",\"ts\":" << (event.startNs - captureStartNs) / 1000.0
+                 << ",\"dur\":" << (event.endNs - event.startNs) / 1000.0 << "}";
+            first = false;
+            ++eventCount;
+        }
+    }
+    file << "\n]}\n";
+
+    std::cout << "Trace: Wrote " << eventCount << " events to " << filepath << std::endl;
+    return file.good();
+}
+
+void setThreadName(const char* name) {
+    auto& buffer = detail::getThreadBuffer();
+    std::lock_guard<std::mutex> lock(detail::g_buffersMutex);
+    buffer.threadName = name;
+}
+
+} // namespace Trace
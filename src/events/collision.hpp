@@ -2,11 +2,23 @@
 
 #include <entt/entt.hpp>
 
+/**
+ * @enum CollisionPhase
+ * @brief Where a touching pair is in its contact lifetime.
+ */
+enum class CollisionPhase {
+    Begin, // First tick the two colliders overlap.
+    Stay,  // Still overlapping; only reported if CollisionEventSettings::reportStay is set.
+    End    // Overlapped last tick but not this one. Either entity may have been destroyed since.
+};
+
 /**
  * @struct CollisionEvent
- * @brief Dispatched by the CollisionSystem when two colliders overlap.
+ * @brief Dispatched by the CollisionSystem when two colliders start touching, keep touching or stop touching.
+ * `a` is the moving body that detected the contact.
  */
 struct CollisionEvent {
     entt::entity a;
     entt::entity b;
+    CollisionPhase phase = CollisionPhase::Begin;
 };
@@ -26,6 +26,10 @@ inline const TMX::Map Level1Map = []{
         .columns = 2,
         .image = TMX::Image{ .source = "ground.tileset", .width = 32, .height = 16 }
     });
+    // The wall tile (GID 2) is solid, for maps loaded with TileCollisionMode::TileGrid.
+    TMX::Properties wallTileProps;
+    wallTileProps.list.emplace_back(TMX::Property{"solid", "bool", std::nullopt, true});
+    map.tilesets.back().tiles.emplace_back(TMX::Tile{ .id = 1, .properties = std::move(wallTileProps) });
 
     // --- Tile Layer ---
     TMX::TileLayer groundLayer;
@@ -1,4 +1,5 @@
 #include "game_scene.hpp"
+#include "../core/trace.hpp"
 #include "../util/resource_manager.hpp"
 #include "../components/transform.hpp"
 #include "../components/sprite.hpp"
@@ -24,12 +25,14 @@ void GameScene::setSystemManager(std::unique_ptr<SystemManager> systemManager) {
 
 void GameScene::load(SDL_Renderer* renderer, ResourceManager* resourceManager,
     InputManager* inputManager, const SceneContext& context) {
+    TRACE_ZONE("GameScene::load");
     m_resourceManager = resourceManager;
     m_inputManager = inputManager;
 
     std::cout << "GameScene loading..." << std::endl;
     // Create the event dispatcher and place it in the registry's context for any system to access.
     m_registry.ctx().emplace<entt::dispatcher>();
+    m_registry.ctx().emplace<RenderInterpolation>();
 
     // Use the loader to populate the registry!
     m_sceneLoader->load(m_registry, renderer, m_resourceManager, m_sceneFilePath);
@@ -71,9 +74,22 @@ void GameScene::update(float deltaTime) {
     m_systemManager->updateAll(m_registry, *m_inputManager, *m_resourceManager, deltaTime);
 }
 
+void GameScene::setInterpolationAlpha(float alpha) {
+    if (m_registry.ctx().contains<RenderInterpolation>()) {
+        m_registry.ctx().get<RenderInterpolation>().alpha = alpha;
+    }
+}
+
 //TODO: is is true that tiles will always be in the background? what about going behind a building in the game?
 void GameScene::render(SDL_Renderer* renderer) {
     // Delegate to the SystemManager
     m_systemManager->drawAll(renderer, m_registry, *m_resourceManager);
 
 }
+
+void GameScene::onRenderTargetsReset() {
+    // Also reached for scenes that are registered but not loaded.
+    if (m_systemManager) {
+        m_systemManager->onRenderTargetsReset();
+    }
+}
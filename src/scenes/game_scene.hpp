@@ -21,7 +21,9 @@ public:
     SceneContext saveState() override;
     void handleEvents(const SDL_Event& event) override;
     void update(float deltaTime) override;
+    void setInterpolationAlpha(float alpha) override;
     void render(SDL_Renderer* renderer) override;
+    void onRenderTargetsReset() override;
 
 private:
     std::unique_ptr<ISceneLoader> m_sceneLoader;
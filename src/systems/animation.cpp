@@ -1,44 +1,69 @@
 #include "animation.hpp"
 #include "../util/sprite_asset_loader.hpp"
 #include "../components/sprite.hpp"
+#include "../core/job_system.hpp"
+
+SystemAccess AnimationSystem::getAccess() const {
+    return SystemAccess{}.readResource<ResourceManager>().write<SpriteComponent>();
+}
+
+void AnimationSystem::init(entt::registry& registry) {
+    m_jobSystem = registry.ctx().contains<JobSystem*>() ? registry.ctx().get<JobSystem*>() : nullptr;
+}
 
 void AnimationSystem::update(entt::registry& registry, InputManager& inputManager,
     ResourceManager& resourceManager, float deltaTime) {
+    // Skip entities that are not animated
     auto view = registry.view<SpriteComponent>();
-
+    m_animatedSprites.clear();
     for (const auto entity : view) {
         auto& sprite = view.get<SpriteComponent>(entity);
-
-        // Skip entities that are not animated
-        if (!sprite.isAnimated) {
-            continue;
+        if (sprite.isAnimated) {
+            m_animatedSprites.push_back(&sprite);
         }
+    }
 
-        // The renderer is not needed for animation logic, so we can pass nullptr.
-        const SpriteAsset* asset = resourceManager.getSpriteAsset(sprite.assetId);
-        if (!asset) {
-            continue;
+    const auto advanceRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            advance(*m_animatedSprites[i], resourceManager, deltaTime);
         }
+    };
+    if (m_jobSystem) {
+        m_jobSystem->parallelFor("AnimationSystem::advance", m_animatedSprites.size(), SPRITES_PER_JOB, advanceRange);
+    } else {
+        advanceRange(0, m_animatedSprites.size());
+    }
+}
 
-        // Find the animation sequence for the sprite's current state
-        auto it = asset->animations.find(sprite.currentState);
-        if (it == asset->animations.end() || it->second.empty()) {
-            continue; // No animation found for this state
-        }
+void AnimationSystem::advance(SpriteComponent& sprite, const ResourceManager& resourceManager, float deltaTime) {
+    // Sprites created outside the scene loaders may not have their handle resolved yet.
+    if (sprite.assetHandle == INVALID_SPRITE_ASSET_HANDLE) {
+        sprite.assetHandle = resourceManager.getSpriteAssetHandle(sprite.assetId);
+    }
+
+    const SpriteAsset* asset = resourceManager.getSpriteAsset(sprite.assetHandle);
+    if (!asset) {
+        return;
+    }
 
-        const AnimationSequence& sequence = it->second;
+    // Get the animation sequence for the sprite's current state (cached until the state changes)
+    const AnimationSequence* cachedSequence = sprite.resolveSequence(*asset);
+    if (!cachedSequence || cachedSequence->empty()) {
+        return; // No animation found for this state
+    }
 
-        // Add elapsed time to the animation timer
-        sprite.animationTimer += deltaTime;
+    const AnimationSequence& sequence = *cachedSequence;
 
-        // Get the duration of the current frame
-        const int currentFrameDurationMs = sequence[sprite.currentFrame].durationMs;
+    // Add elapsed time to the animation timer
+    sprite.animationTimer += deltaTime;
 
-        // Check if it's time to advance to the next frame
-        if (sprite.animationTimer * 1000.0f >= currentFrameDurationMs) {
-            sprite.animationTimer = 0.0f; // Reset timer
-            // Advance to the next frame, looping back to the start if at the end
-            sprite.currentFrame = (sprite.currentFrame + 1) % sequence.size();
-        }
+    // Get the duration of the current frame
+    const int currentFrameDurationMs = sequence[sprite.currentFrame].durationMs;
+
+    // Check if it's time to advance to the next frame
+    if (sprite.animationTimer * 1000.0f >= currentFrameDurationMs) {
+        sprite.animationTimer = 0.0f; // Reset timer
+        // Advance to the next frame, looping back to the start if at the end
+        sprite.currentFrame = (sprite.currentFrame + 1) % sequence.size();
     }
-}
\ No newline at end of file
+}
@@ -2,11 +2,22 @@
 
 #include "../core/systems/isystem.hpp"
 #include "../util/resource_manager.hpp"
+#include <vector>
+
+class JobSystem;
+struct SpriteComponent;
 
 class AnimationSystem: public IUpdateSystem {
 public:
+    const char* getName() const override { return "AnimationSystem"; }
+    SystemAccess getAccess() const override;
     AnimationSystem() = default;
 
+    /**
+     * @brief Picks up the engine's JobSystem from the context if present, to advance sprites in parallel.
+     */
+    void init(entt::registry& registry) override;
+
     /**
      * @brief Updates the animation frame for all animated entities.
      * @param registry The scene's entity registry.
@@ -16,4 +27,14 @@ public:
      */
     void update(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager,
         float deltaTime) override;
+
+private:
+    // Animated sprites per job; each sprite only depends on itself, so any split works.
+    static constexpr size_t SPRITES_PER_JOB = 512;
+
+    JobSystem* m_jobSystem = nullptr;
+    // Reused every tick: the animated sprites, collected before the parallel pass.
+    std::vector<SpriteComponent*> m_animatedSprites;
+
+    static void advance(SpriteComponent& sprite, const ResourceManager& resourceManager, float deltaTime);
 };
@@ -9,22 +9,31 @@ void BehaviorSystem::init(entt::registry& registry) {
 }
 
 void BehaviorSystem::onCollision(const CollisionEvent& event) {
-    auto& registry = *m_registry;
+    // End events can arrive after either entity was destroyed, and the first behavior might destroy
+    // the second entity, so both are checked right before use.
+    respond(event.a, event.b, event.phase);
+    respond(event.b, event.a, event.phase);
+}
 
-    // Check if the first entity has a behavior to execute.
-    if (auto* behavior = registry.try_get<BehaviorComponent>(event.a)) {
-        if (behavior->responder) {
-            behavior->responder->onCollision(event.a, event.b, registry);
-        }
+void BehaviorSystem::respond(entt::entity self, entt::entity other, CollisionPhase phase) {
+    auto& registry = *m_registry;
+    if (!registry.valid(self)) {
+        return;
+    }
+    auto* behavior = registry.try_get<BehaviorComponent>(self);
+    if (!behavior || !behavior->responder) {
+        return;
     }
 
-    // Check if the second entity has a behavior to execute.
-    // Important: check registry is still valid, as the first behavior might have destroyed it.
-    if (registry.valid(event.b)) {
-        if (auto* behavior = registry.try_get<BehaviorComponent>(event.b)) {
-            if (behavior->responder) {
-                behavior->responder->onCollision(event.b, event.a, registry);
-            }
-        }
+    switch (phase) {
+        case CollisionPhase::Begin:
+            behavior->responder->onCollision(self, other, registry);
+            break;
+        case CollisionPhase::Stay:
+            behavior->responder->onCollisionStay(self, other, registry);
+            break;
+        case CollisionPhase::End:
+            behavior->responder->onCollisionEnd(self, other, registry);
+            break;
     }
 }
@@ -8,6 +8,7 @@
 #include <entt/entt.hpp>
 
 struct CollisionEvent;
+enum class CollisionPhase;
 
 /**
  * @class BehaviorSystem
@@ -15,8 +16,9 @@ struct CollisionEvent;
  *
  * This system subscribes to `CollisionEvent`s dispatched within the application.
  * When a collision occurs, it checks if either of the involved entities has a
- * `BehaviorComponent`. If a component is found, the system invokes the `onCollision`
- * method of the `ICollisionResponder` held by that component.
+ * `BehaviorComponent`. If a component is found, the system invokes the `onCollision`,
+ * `onCollisionStay` or `onCollisionEnd` method of the `ICollisionResponder` held by that
+ * component, depending on the event's phase.
  *
  * This design effectively decouples collision response logic from monolithic systems
  * (like a `GameplaySystem`). Instead of hard-coding "if player hits coin, destroy coin",
@@ -31,6 +33,11 @@ struct CollisionEvent;
 //TODO: discuss if this is the right name for the behavior given it's responsability
 class BehaviorSystem : public IUpdateSystem {
 public:
+    const char* getName() const override { return "BehaviorSystem"; }
+    /**
+     * @brief Touches nothing during update(); its responders run later, from the dispatcher.
+     */
+    SystemAccess getAccess() const override { return SystemAccess{}; }
     /**
      * @brief Initializes the system and subscribes to collision events.
      * @param registry The central entity-component-system registry.
@@ -52,6 +59,11 @@ private:
     */
     void onCollision(const CollisionEvent& event);
 
+    /**
+     * @brief Forwards one side of a collision event to `self`'s responder, if it is still alive and has one.
+     */
+    void respond(entt::entity self, entt::entity other, CollisionPhase phase);
+
     /**
      * @brief A cached pointer to the registry.
      *
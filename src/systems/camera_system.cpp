@@ -12,6 +12,11 @@ static float lerp(float a, float b, float t) {
     return a + t * (b - a);
 }
 
+SystemAccess CameraSystem::getAccess() const {
+    // The camera follows its target's transform and moves its own.
+    return SystemAccess{}.read<BlackboardComponent>().write<TransformComponent>();
+}
+
 void CameraSystem::update(entt::registry& registry, InputManager& inputManager,
         ResourceManager& resourceManager, float deltaTime) {
     if (!registry.ctx().contains<ActiveCamera>()) return; // No camera to update
@@ -24,14 +29,14 @@ void CameraSystem::update(entt::registry& registry, InputManager& inputManager,
     float followSpeed = 0.0f; // 0.0f means hard lock
     float deadZoneRadius = 0.0f;
 
-    if (auto it = blackboard.values.find(BlackboardKeys::Camera::Target); it != blackboard.values.end()) {
-        target = std::any_cast<entt::entity>(it->second);
+    if (const auto* value = blackboard.get<entt::entity>(BlackboardKeys::Camera::Target)) {
+        target = *value;
     }
-    if (auto it = blackboard.values.find(BlackboardKeys::Camera::FollowSpeed); it != blackboard.values.end()) {
-        followSpeed = std::any_cast<float>(it->second);
+    if (const auto* value = blackboard.get<float>(BlackboardKeys::Camera::FollowSpeed)) {
+        followSpeed = *value;
     }
-    if (auto it = blackboard.values.find(BlackboardKeys::Camera::DeadZoneRadius); it != blackboard.values.end()) {
-        deadZoneRadius = std::any_cast<float>(it->second);
+    if (const auto* value = blackboard.get<float>(BlackboardKeys::Camera::DeadZoneRadius)) {
+        deadZoneRadius = *value;
     }
 
     if (target == entt::null || !registry.valid(target)) return;
@@ -4,6 +4,8 @@
 
 class CameraSystem: public IUpdateSystem {
 public:
+    const char* getName() const override { return "CameraSystem"; }
+    SystemAccess getAccess() const override;
     CameraSystem() = default;
 
     void update(entt::registry& registry, InputManager& inputManager,
@@ -7,6 +7,10 @@
 #include "../core/blackboard_keys.hpp"
 #include <iostream>
 
+SystemAccess CharacterControllerSystem::getAccess() const {
+    return SystemAccess{}.read<IntentComponent, MovementComponent>().write<RigidBodyComponent, BlackboardComponent>();
+}
+
 void CharacterControllerSystem::update(entt::registry& registry, InputManager& inputManager,
         ResourceManager& resourceManager, float deltaTime) {
     // This system acts on any entity that has an intent and movement stats.
@@ -33,8 +37,6 @@ void CharacterControllerSystem::update(entt::registry& registry, InputManager& i
         }
 
         // We can also move the Blackboard update here.
-        if (auto* blackboard = registry.try_get<BlackboardComponent>(entity)) {
-            blackboard->values[BlackboardKeys::State::IsMoving] = (intent.moveDirection.x != 0.0f || intent.moveDirection.y != 0.0f);
-        }
+        blackboard.set(BlackboardKeys::State::IsMoving, intent.moveDirection.x != 0.0f || intent.moveDirection.y != 0.0f);
     }
 }
@@ -4,6 +4,8 @@
 
 class CharacterControllerSystem: public IUpdateSystem {
 public:
+    const char* getName() const override { return "CharacterControllerSystem"; }
+    SystemAccess getAccess() const override;
     CharacterControllerSystem() = default;
 
     void update(entt::registry& registry, InputManager& inputManager,
@@ -1,7 +1,11 @@
 #include "collision_system.hpp"
 #include "../components/transform.hpp"
 #include "../components/collider.hpp"
+#include "../components/tile_collision.hpp"
 #include "../events/collision.hpp"
+#include "../core/context.hpp"
+#include "../core/trace.hpp"
+#include "../core/job_system.hpp"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -26,8 +30,80 @@ static Vec2f calculateMTV(const QuadtreeRect& a, const QuadtreeRect& b) {
     }
 }
 
-CollisionSystem::CollisionSystem(const QuadtreeRect& worldBounds) {
-    m_quadtree = std::make_unique<Quadtree<entt::entity>>(0, worldBounds);
+CollisionSystem::CollisionSystem(const QuadtreeRect& worldBounds, BroadPhaseType broadPhaseType)
+    : m_worldBounds(worldBounds), m_broadPhaseType(broadPhaseType) {
+    m_staticBroadPhase = createBroadPhase(getStaticBroadPhaseType(), m_worldBounds, BroadPhaseSettings{}.cellSize);
+    m_sleepingBroadPhase = createBroadPhase(getStaticBroadPhaseType(), m_worldBounds, BroadPhaseSettings{}.cellSize);
+    m_dynamicBroadPhase = createBroadPhase(m_broadPhaseType, m_worldBounds, BroadPhaseSettings{}.cellSize);
+}
+
+SystemAccess CollisionSystem::getAccess() const {
+    // Contacts push bodies apart and wake sleepers; events are only enqueued, never triggered.
+    return SystemAccess{}
+        .read<ColliderComponent, TileCollisionGridComponent>()
+        .write<TransformComponent, RigidBodyComponent, SleepingComponent>()
+        .writeResource<entt::dispatcher>();
+}
+
+void CollisionSystem::init(entt::registry& registry) {
+    // Recreated per scene so the cell size follows the scene that was just loaded.
+    BroadPhaseSettings settings;
+    if (registry.ctx().contains<BroadPhaseSettings>()) {
+        settings = registry.ctx().get<BroadPhaseSettings>();
+    }
+    m_staticBroadPhase = createBroadPhase(getStaticBroadPhaseType(), m_worldBounds, settings.cellSize);
+    m_sleepingBroadPhase = createBroadPhase(getStaticBroadPhaseType(), m_worldBounds, settings.cellSize);
+    m_dynamicBroadPhase = createBroadPhase(m_broadPhaseType, m_worldBounds, settings.cellSize);
+    m_isStaticBroadPhaseDirty = true;
+    m_isSleepingBroadPhaseDirty = true;
+
+    m_jobSystem = registry.ctx().contains<JobSystem*>() ? registry.ctx().get<JobSystem*>() : nullptr;
+
+    m_isReportingStay = registry.ctx().contains<CollisionEventSettings>()
+        && registry.ctx().get<CollisionEventSettings>().reportStay;
+    // Pairs from a previous scene refer to entities that no longer exist.
+    m_previousTouchingPairs.clear();
+
+    // Any of these can add a collider to, or remove one from, the static set.
+    registry.on_construct<ColliderComponent>().connect<&CollisionSystem::onStaticSetChanged>(this);
+    registry.on_update<ColliderComponent>().connect<&CollisionSystem::onStaticSetChanged>(this);
+    registry.on_destroy<ColliderComponent>().connect<&CollisionSystem::onStaticSetChanged>(this);
+    registry.on_construct<RigidBodyComponent>().connect<&CollisionSystem::onStaticSetChanged>(this);
+    registry.on_update<RigidBodyComponent>().connect<&CollisionSystem::onStaticSetChanged>(this);
+    registry.on_destroy<RigidBodyComponent>().connect<&CollisionSystem::onStaticSetChanged>(this);
+    // The PhysicsSystem puts bodies to sleep; anything may wake them.
+    registry.on_construct<SleepingComponent>().connect<&CollisionSystem::onSleepingSetChanged>(this);
+    registry.on_destroy<SleepingComponent>().connect<&CollisionSystem::onSleepingSetChanged>(this);
+}
+
+BroadPhaseType CollisionSystem::getStaticBroadPhaseType() const {
+    // Sweep-and-prune pays off through frame-to-frame coherence of moving bodies; static colliders
+    // are only ever queried by area, which a tree answers better.
+    return m_broadPhaseType == BroadPhaseType::SweepAndPrune ? BroadPhaseType::LinearQuadtree : m_broadPhaseType;
+}
+
+bool CollisionSystem::isStaticCollider(const ColliderComponent& collider, const RigidBodyComponent* rigidbody) {
+    return collider.is_static || !rigidbody || rigidbody->bodyType == BodyType::STATIC;
+}
+
+void CollisionSystem::onStaticSetChanged(entt::registry&, entt::entity) {
+    // Rebuilt lazily on the next update, so loading a map with many walls costs a single rebuild.
+    m_isStaticBroadPhaseDirty = true;
+    // A sleeping body's collider or rigidbody may have changed too.
+    m_isSleepingBroadPhaseDirty = true;
+}
+
+void CollisionSystem::onSleepingSetChanged(entt::registry&, entt::entity) {
+    m_isSleepingBroadPhaseDirty = true;
+}
+
+bool CollisionSystem::isRestingContactSide(const entt::registry& registry, entt::entity entity) {
+    if (!registry.valid(entity)) return false;
+    // The tile grid stands in for its tiles, which never move.
+    if (registry.all_of<TileCollisionGridComponent>(entity)) return true;
+    const auto* collider = registry.try_get<ColliderComponent>(entity);
+    if (!collider) return false;
+    return registry.all_of<SleepingComponent>(entity) || isStaticCollider(*collider, registry.try_get<RigidBodyComponent>(entity));
 }
 
 // Helper function to create a QuadtreeRect from an entity's components
@@ -50,6 +126,69 @@ static QuadtreeRect getEntityBounds(const TransformComponent& transform, const C
     };
 }
 
+void CollisionSystem::rebuildStaticBroadPhase(entt::registry& registry) {
+    TRACE_ZONE("CollisionSystem::rebuildStaticBroadPhase");
+    m_staticBroadPhase->clear();
+    m_staticProxies.clear();
+    auto view = registry.view<const TransformComponent, const ColliderComponent>();
+    for (const auto entity : view) {
+        const auto& [transform, collider] = view.get<const TransformComponent, const ColliderComponent>(entity);
+        if (!isStaticCollider(collider, registry.try_get<RigidBodyComponent>(entity))) continue;
+
+        const auto id = static_cast<BroadPhaseProxyId>(m_staticProxies.size());
+        m_staticProxies.push_back({entity, getEntityBounds(transform, collider), collider.layer, collider.mask, collider.is_trigger});
+        m_staticBroadPhase->insert(id, m_staticProxies.back().bounds);
+    }
+    m_isStaticBroadPhaseDirty = false;
+}
+
+void CollisionSystem::rebuildSleepingBroadPhase(entt::registry& registry) {
+    TRACE_ZONE("CollisionSystem::rebuildSleepingBroadPhase");
+    m_sleepingBroadPhase->clear();
+    m_sleepingProxies.clear();
+    auto view = registry.view<const TransformComponent, const RigidBodyComponent, const ColliderComponent, const SleepingComponent>();
+    for (const auto entity : view) {
+        const auto& [transform, rigidbody, collider] = view.get<const TransformComponent, const RigidBodyComponent, const ColliderComponent>(entity);
+        if (isStaticCollider(collider, &rigidbody)) continue;
+
+        const auto id = static_cast<BroadPhaseProxyId>(m_sleepingProxies.size());
+        m_sleepingProxies.push_back({entity, getEntityBounds(transform, collider), collider.layer, collider.mask, collider.is_trigger});
+        m_sleepingBroadPhase->insert(id, m_sleepingProxies.back().bounds);
+    }
+    m_isSleepingBroadPhaseDirty = false;
+}
+
+void CollisionSystem::gatherDynamicProxies(entt::registry& registry) {
+    m_dynamicBroadPhase->clear();
+    m_dynamicProxies.clear();
+    // Sleeping bodies never initiate checks; awake bodies find them in the sleeping broad phase.
+    auto view = registry.view<TransformComponent, RigidBodyComponent, const ColliderComponent>(entt::exclude<SleepingComponent>);
+    for (const auto entity : view) {
+        auto [transform, rigidbody, collider] = view.get<TransformComponent, RigidBodyComponent, const ColliderComponent>(entity);
+        if (isStaticCollider(collider, &rigidbody)) continue;
+
+        const auto id = static_cast<BroadPhaseProxyId>(m_dynamicProxies.size());
+        m_dynamicProxies.push_back({entity, getEntityBounds(transform, collider), &transform, &rigidbody, &collider});
+        m_dynamicBroadPhase->insert(id, m_dynamicProxies.back().bounds);
+    }
+}
+
+void CollisionSystem::findDynamicPairs() {
+    m_dynamicPairs.clear();
+    if (!m_dynamicBroadPhase->queryPairs(m_dynamicPairs)) {
+        // No direct pair search: one query per body, keeping each unordered pair once.
+        for (BroadPhaseProxyId selfId = 0; selfId < m_dynamicProxies.size(); ++selfId) {
+            m_dynamicCandidates.clear();
+            m_dynamicBroadPhase->query(m_dynamicProxies[selfId].bounds, m_dynamicCandidates);
+            for (const auto otherId : m_dynamicCandidates) {
+                if (otherId > selfId) m_dynamicPairs.emplace_back(selfId, otherId);
+            }
+        }
+    }
+    // Resolve in a fixed order whatever order the broad phase reported pairs in.
+    std::sort(m_dynamicPairs.begin(), m_dynamicPairs.end());
+}
+
 // Helper for the AABB intersection check
 static bool checkAABBCollision(const QuadtreeRect& a, const QuadtreeRect& b) {
     return (a.x < b.x + b.w && a.x + a.w > b.x &&
@@ -119,77 +258,314 @@ void CollisionSystem::update(entt::registry& registry, InputManager&, ResourceMa
     auto& dispatcher = registry.ctx().get<entt::dispatcher>();
 
     // === 1. BROAD PHASE ===
-    // Clear the quadtree and re-populate it with all colliders.
-    m_quadtree->clear();
-    auto allCollidersView = registry.view<const TransformComponent, const ColliderComponent>();
-    for (const auto entity : allCollidersView) {
-        const auto& [transform, collider] = allCollidersView.get<const TransformComponent, const ColliderComponent>(entity);
-        m_quadtree->insert(entity, getEntityBounds(transform, collider));
-    }
-
-    // === 2. NARROW PHASE === (with depenetration)
-    // We only need to check moving objects against the quadtree.
-    auto dynamicEntitiesView = registry.view<TransformComponent, RigidBodyComponent,
-    const ColliderComponent>();
-    for (const auto entity : dynamicEntitiesView) {
-        // We only need to check DYNAMIC bodies, as static ones don't initiate collision checks.
-        auto& rigidbody = dynamicEntitiesView.get<RigidBodyComponent>(entity);
-        if (rigidbody.bodyType == BodyType::STATIC) continue;
-
-        // ---(Get potential collisions from Quadtree) ---
-        auto& transform = dynamicEntitiesView.get<TransformComponent>(entity);
-        const auto& collider = dynamicEntitiesView.get<const ColliderComponent>(entity);
-
-        // Get potentials collisions from Quadtree
-        QuadtreeRect entityBounds = getEntityBounds(transform, collider);
-        std::vector<entt::entity> potentialCollisions;
-        m_quadtree->query(entityBounds, potentialCollisions);
-        
-        for (const auto otherEntity : potentialCollisions) {
-            // Don't check an entity against itself.
-            if (entity == otherEntity) {
-                continue;
+    // Static colliders persist across ticks; only moving bodies are re-inserted every tick,
+    // so this cost scales with the number of moving objects rather than the level size.
+    if (m_isStaticBroadPhaseDirty) {
+        rebuildStaticBroadPhase(registry);
+    }
+    // Bodies at rest are handled the same way, so a settled pile of crates costs no more than walls.
+    if (m_isSleepingBroadPhaseDirty) {
+        rebuildSleepingBroadPhase(registry);
+    }
+    gatherDynamicProxies(registry);
+    findDynamicPairs();
+
+    // A map loaded in TileGrid mode keeps its walls here instead of as collider entities.
+    const TileCollisionGridComponent* tileGrid = nullptr;
+    entt::entity tileGridEntity = entt::null;
+    auto tileGridView = registry.view<const TileCollisionGridComponent>();
+    if (tileGridView.begin() != tileGridView.end()) {
+        tileGridEntity = *tileGridView.begin();
+        tileGrid = &tileGridView.get<const TileCollisionGridComponent>(tileGridEntity);
+    }
+
+    // === 2. DETECTION === (parallel, read-only)
+    // Only moving bodies initiate checks, against the bounds they had at the start of the tick.
+    // Nothing moves yet, so the bodies can be split across threads.
+    detectContacts();
+
+    // === 3. RESOLUTION === (serial, with depenetration)
+    // One thread, in contact order, so every thread count produces exactly the same positions.
+    resolveContacts(registry, tileGridEntity, tileGrid);
+
+    // === 4. EVENTS ===
+    // Only changes are reported, so listeners don't run every tick two things keep touching.
+    reportCollisionEvents(registry, dispatcher);
+}
+
+void CollisionSystem::detectContacts() {
+    const size_t bodyCount = m_dynamicProxies.size();
+    const size_t availableThreads = m_jobSystem ? m_jobSystem->getThreadCount() : 1;
+    const size_t threadCount = m_detectionThreadCount > 0
+        ? std::min<size_t>(m_detectionThreadCount, availableThreads) : availableThreads;
+    const size_t batchCount = std::clamp<size_t>(bodyCount / MIN_BODIES_PER_DETECTION_BATCH, 1, threadCount);
+
+    // Contiguous body ranges, so concatenating the batches in order gives the same contact list
+    // for any number of batches.
+    if (m_detectionBatches.size() < batchCount) {
+        m_detectionBatches.resize(batchCount);
+    }
+    for (size_t i = 0; i < batchCount; ++i) {
+        m_detectionBatches[i].firstBody = static_cast<BroadPhaseProxyId>(bodyCount * i / batchCount);
+        m_detectionBatches[i].endBody = static_cast<BroadPhaseProxyId>(bodyCount * (i + 1) / batchCount);
+    }
+
+    // Lazy broad phases must finish building here, before several threads query them.
+    m_staticBroadPhase->build();
+    m_sleepingBroadPhase->build();
+
+    if (batchCount == 1) {
+        detectBatch(m_detectionBatches[0]);
+    } else {
+        m_jobSystem->parallelFor("CollisionSystem::detectContacts", batchCount, 1, [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                detectBatch(m_detectionBatches[i]);
             }
+        });
+    }
 
-            const auto& otherCollider = registry.get<const ColliderComponent>(otherEntity);
+    // === Merge ===
+    m_contacts.clear();
+    for (size_t i = 0; i < batchCount; ++i) {
+        const auto& contacts = m_detectionBatches[i].contacts;
+        m_contacts.insert(m_contacts.end(), contacts.begin(), contacts.end());
+    }
+}
+
+void CollisionSystem::detectBatch(DetectionBatch& batch) {
+    TRACE_ZONE("CollisionSystem::detectBatch");
+    batch.contacts.clear();
+
+    // Pairs are sorted by their first id, so this batch's pairs are one contiguous run.
+    auto pair = std::lower_bound(m_dynamicPairs.begin(), m_dynamicPairs.end(), BroadPhasePair{batch.firstBody, 0});
+
+    for (BroadPhaseProxyId selfId = batch.firstBody; selfId < batch.endBody; ++selfId) {
+        const DynamicProxy& self = m_dynamicProxies[selfId];
+        const ColliderComponent& collider = *self.collider;
+
+        // --- Against static colliders ---
+        batch.staticCandidates.clear();
+        m_staticBroadPhase->query(self.bounds, batch.staticCandidates);
+        // Broad phases report candidates in their own order; sort so resolution doesn't depend on it.
+        std::sort(batch.staticCandidates.begin(), batch.staticCandidates.end());
+        for (const auto otherId : batch.staticCandidates) {
+            const StaticProxy& other = m_staticProxies[otherId];
             // Check if the physics layers and masks allow for a collision.
+            bool canCollide = (collider.mask & other.layer) && (other.mask & collider.layer);
+            if (canCollide && checkAABBCollision(self.bounds, other.bounds)) {
+                batch.contacts.push_back({selfId, otherId, ContactKind::Static});
+            }
+        }
+
+        // --- Against sleeping bodies ---
+        if (!m_sleepingProxies.empty()) {
+            batch.sleepingCandidates.clear();
+            m_sleepingBroadPhase->query(self.bounds, batch.sleepingCandidates);
+            std::sort(batch.sleepingCandidates.begin(), batch.sleepingCandidates.end());
+            for (const auto otherId : batch.sleepingCandidates) {
+                const StaticProxy& other = m_sleepingProxies[otherId];
+                bool canCollide = (collider.mask & other.layer) && (other.mask & collider.layer);
+                if (canCollide && checkAABBCollision(self.bounds, other.bounds)) {
+                    batch.contacts.push_back({selfId, otherId, ContactKind::Sleeping});
+                }
+            }
+        }
+
+        // --- Against other moving bodies: each unordered pair once, from its lower id ---
+        for (; pair != m_dynamicPairs.end() && pair->first == selfId; ++pair) {
+            const ColliderComponent& otherCollider = *m_dynamicProxies[pair->second].collider;
             bool canCollide = (collider.mask & otherCollider.layer) && (otherCollider.mask & collider.layer);
-            if (!canCollide) {
-                continue;
+            if (canCollide) {
+                batch.contacts.push_back({selfId, pair->second, ContactKind::Moving});
             }
+        }
+    }
+}
 
-            const auto& otherConstTransform = registry.get<const TransformComponent>(otherEntity);
-            const auto otherBounds = getEntityBounds(otherConstTransform, otherCollider);
+void CollisionSystem::resolveContacts(entt::registry& registry, entt::entity tileGridEntity, const TileCollisionGridComponent* tileGrid) {
+    m_touchingPairs.clear();
+    size_t contactCursor = 0; // Contacts are ordered by body, so each body's contacts are contiguous.
+    for (BroadPhaseProxyId selfId = 0; selfId < m_dynamicProxies.size(); ++selfId) {
+        DynamicProxy& self = m_dynamicProxies[selfId];
+        const ColliderComponent& collider = *self.collider;
+
+        for (; contactCursor < m_contacts.size() && m_contacts[contactCursor].selfId == selfId; ++contactCursor) {
+            const Contact& contact = m_contacts[contactCursor];
+
+            // --- Against a static collider: always an immovable wall ---
+            if (contact.kind == ContactKind::Static) {
+                const StaticProxy& other = m_staticProxies[contact.otherId];
+                // Earlier contacts this tick may already have pushed the body clear.
+                if (!checkAABBCollision(self.bounds, other.bounds)) {
+                    continue;
+                }
 
-            // TODO: I dont think resolution should go here? since every object should be able to react differently to collisions. Or maybe yes? this is a discussion topic.
-            if (checkAABBCollision(entityBounds, otherBounds)) {
                 //TODO: discuss if this component should be responsible for resolution
-                dispatcher.enqueue<CollisionEvent>(entity, otherEntity);
+                addTouchingPair(self.entity, other.entity);
 
                 // Now, check if we should skip the physical resolution part.
-                if (collider.is_trigger || otherCollider.is_trigger) {
+                if (collider.is_trigger || other.isTrigger) {
                     continue;
                 }
+                resolveStaticCollision(*self.transform, self.bounds, other.bounds);
+                self.bounds = getEntityBounds(*self.transform, collider);
+                continue;
+            }
+
+            // --- Against a sleeping (always DYNAMIC) body: it wakes up and is resolved like a moving one ---
+            if (contact.kind == ContactKind::Sleeping) {
+                StaticProxy& other = m_sleepingProxies[contact.otherId];
+                if (!checkAABBCollision(self.bounds, other.bounds)) {
+                    continue;
+                }
+                addTouchingPair(self.entity, other.entity);
+                if (collider.is_trigger || other.isTrigger) {
+                    continue; // Passing through a trigger doesn't disturb a sleeper.
+                }
 
-                //TODO: again im thinking this resolution should not be part of the collission system but for more specialized systems.
-                // Safely try to get the other entity's rigidbody.
-                auto* otherRigidbody = registry.try_get<RigidBodyComponent>(otherEntity);
-                if (otherRigidbody) {
-                    // --- COLLISION RESPONSE ---
-                    // If the other body is STATIC OR KINEMATIC, treat it as an immovable wall.
-                    if (otherRigidbody->bodyType == BodyType::STATIC ||
-                        otherRigidbody->bodyType == BodyType::KINEMATIC) {
-                        resolveStaticCollision(transform, entityBounds, otherBounds);
-                    } else if (otherRigidbody->bodyType == BodyType::DYNAMIC) { // Both bodies are DYNAMIC.
-                        auto& otherMutableTransform = registry.get<TransformComponent>(otherEntity);
-                        resolveDynamicCollision(transform, rigidbody, entityBounds,
-                            otherMutableTransform, *otherRigidbody, otherBounds);
-                    }
+                if (registry.all_of<SleepingComponent>(other.entity)) {
+                    // Rebuilds the sleeping set next tick; its proxy stays valid for the rest of this one.
+                    registry.remove<SleepingComponent>(other.entity);
+                }
+                auto& otherTransform = registry.get<TransformComponent>(other.entity);
+                if (self.rigidbody->bodyType == BodyType::DYNAMIC) {
+                    auto& otherRigidbody = registry.get<RigidBodyComponent>(other.entity);
+                    resolveDynamicCollision(*self.transform, *self.rigidbody, self.bounds,
+                        otherTransform, otherRigidbody, other.bounds);
+                    self.bounds = getEntityBounds(*self.transform, collider);
                 } else {
-                    // The other entity does NOT have a rigidbody, so treat it as a simple static wall.
-                    resolveStaticCollision(transform, entityBounds, otherBounds);
+                    // A KINEMATIC body is a wall: only the sleeper is pushed out of it.
+                    resolveStaticCollision(otherTransform, other.bounds, self.bounds);
                 }
+                other.bounds = getEntityBounds(otherTransform, registry.get<ColliderComponent>(other.entity));
+                continue;
             }
+
+            // --- Against another moving body ---
+            DynamicProxy& other = m_dynamicProxies[contact.otherId];
+            const ColliderComponent& otherCollider = *other.collider;
+            if (!checkAABBCollision(self.bounds, other.bounds)) {
+                continue;
+            }
+
+            // TODO: I dont think resolution should go here? since every object should be able to react differently to collisions. Or maybe yes? this is a discussion topic.
+            addTouchingPair(self.entity, other.entity);
+
+            if (collider.is_trigger || otherCollider.is_trigger) {
+                continue;
+            }
+
+            //TODO: again im thinking this resolution should not be part of the collission system but for more specialized systems.
+            // --- COLLISION RESPONSE ---
+            // Each pair is resolved once, from the lower id, so the outcome must not depend on which side that is:
+            // a KINEMATIC body is an immovable wall for a DYNAMIC one, whichever of them is self.
+            const bool isSelfDynamic = self.rigidbody->bodyType == BodyType::DYNAMIC;
+            const bool isOtherDynamic = other.rigidbody->bodyType == BodyType::DYNAMIC;
+            if (isSelfDynamic && isOtherDynamic) {
+                resolveDynamicCollision(*self.transform, *self.rigidbody, self.bounds,
+                    *other.transform, *other.rigidbody, other.bounds);
+                other.bounds = getEntityBounds(*other.transform, otherCollider);
+                self.bounds = getEntityBounds(*self.transform, collider);
+            } else if (isOtherDynamic) {
+                resolveStaticCollision(*other.transform, other.bounds, self.bounds);
+                other.bounds = getEntityBounds(*other.transform, otherCollider);
+            } else {
+                // self is DYNAMIC against a KINEMATIC wall, or two KINEMATIC bodies: self steps back, as before.
+                resolveStaticCollision(*self.transform, self.bounds, other.bounds);
+                self.bounds = getEntityBounds(*self.transform, collider);
+            }
+        }
+
+        // --- Tile walls baked into a solidity grid (no entities, no broad phase) ---
+        if (tileGrid) {
+            if (resolveTileGridCollision(*self.transform, collider, *tileGrid)) {
+                // The tilemap entity stands in for the tiles, so this is one pair however many were touched.
+                addTouchingPair(self.entity, tileGridEntity);
+            }
+            self.bounds = getEntityBounds(*self.transform, collider);
         }
     }
 }
+
+void CollisionSystem::addTouchingPair(entt::entity a, entt::entity b) {
+    const uint64_t first = entt::to_integral(a), second = entt::to_integral(b);
+    const uint64_t key = first < second ? (first << 32 | second) : (second << 32 | first);
+    m_touchingPairs.push_back({key, a, b});
+}
+
+void CollisionSystem::reportCollisionEvents(entt::registry& registry, entt::dispatcher& dispatcher) {
+    std::sort(m_touchingPairs.begin(), m_touchingPairs.end());
+    m_touchingPairs.erase(std::unique(m_touchingPairs.begin(), m_touchingPairs.end(),
+        [](const TouchingPair& a, const TouchingPair& b) { return a.key == b.key; }), m_touchingPairs.end());
+
+    // Both lists are sorted by key: one merge pass finds what started, stayed and ended.
+    m_restingTouchingPairs.clear();
+    auto current = m_touchingPairs.begin();
+    auto previous = m_previousTouchingPairs.begin();
+    while (current != m_touchingPairs.end() || previous != m_previousTouchingPairs.end()) {
+        if (previous == m_previousTouchingPairs.end() || (current != m_touchingPairs.end() && current->key < previous->key)) {
+            dispatcher.enqueue<CollisionEvent>(current->a, current->b, CollisionPhase::Begin);
+            ++current;
+        } else if (current == m_touchingPairs.end() || previous->key < current->key) {
+            // Nobody checked a pair whose sides are both asleep or static: it is still touching.
+            // Anything else that wasn't found again (moved apart, lost its collider, destroyed) has ended.
+            const bool isResting = isRestingContactSide(registry, previous->a) && isRestingContactSide(registry, previous->b);
+            if (isResting) {
+                m_restingTouchingPairs.push_back(*previous);
+                if (m_isReportingStay) {
+                    dispatcher.enqueue<CollisionEvent>(previous->a, previous->b, CollisionPhase::Stay);
+                }
+            } else {
+                dispatcher.enqueue<CollisionEvent>(previous->a, previous->b, CollisionPhase::End);
+            }
+            ++previous;
+        } else {
+            if (m_isReportingStay) {
+                dispatcher.enqueue<CollisionEvent>(current->a, current->b, CollisionPhase::Stay);
+            }
+            ++current;
+            ++previous;
+        }
+    }
+
+    if (!m_restingTouchingPairs.empty()) {
+        // Both runs are sorted; keep the whole list sorted for next tick's merge.
+        const auto middle = m_touchingPairs.insert(m_touchingPairs.end(), m_restingTouchingPairs.begin(), m_restingTouchingPairs.end());
+        std::inplace_merge(m_touchingPairs.begin(), middle, m_touchingPairs.end());
+    }
+    std::swap(m_touchingPairs, m_previousTouchingPairs);
+}
+
+bool CollisionSystem::resolveTileGridCollision(TransformComponent& transform, const ColliderComponent& collider,
+    const TileCollisionGridComponent& grid) {
+    bool canCollide = (collider.mask & grid.layer) && (grid.mask & collider.layer);
+    if (!canCollide || grid.tileWidth <= 0 || grid.tileHeight <= 0) {
+        return false;
+    }
+
+    // Only the few cells under the body's bounds are visited.
+    QuadtreeRect bounds = getEntityBounds(transform, collider);
+    const int minCol = std::max(0, bounds.x / grid.tileWidth);
+    const int minRow = std::max(0, bounds.y / grid.tileHeight);
+    const int maxCol = std::min(grid.widthInTiles - 1, (bounds.x + bounds.w) / grid.tileWidth);
+    const int maxRow = std::min(grid.heightInTiles - 1, (bounds.y + bounds.h) / grid.tileHeight);
+
+    bool touched = false;
+    for (int row = minRow; row <= maxRow; ++row) {
+        for (int col = minCol; col <= maxCol; ++col) {
+            if (!grid.isSolid(col, row)) continue;
+
+            const QuadtreeRect cellBounds = {col * grid.tileWidth, row * grid.tileHeight, grid.tileWidth, grid.tileHeight};
+            if (!checkAABBCollision(bounds, cellBounds)) continue;
+            touched = true;
+
+            if (!collider.is_trigger) {
+                resolveStaticCollision(transform, bounds, cellBounds);
+                // Re-read the bounds so the next cell sees the pushed position; this avoids double pushes at tile seams.
+                bounds = getEntityBounds(transform, collider);
+            }
+        }
+    }
+
+    return touched;
+}
@@ -1,21 +1,184 @@
 #pragma once
 
 #include "../core/systems/isystem.hpp"
-#include "../util/quadtree.hpp"
+#include "../util/broad_phase.hpp"
 #include "../components/transform.hpp"
 #include "../components/rigidbody.hpp"
+#include "../components/collider.hpp"
+#include "../components/tile_collision.hpp"
 #include <memory>
+#include <vector>
 #include <entt/entt.hpp>
 
+class JobSystem;
+
 class CollisionSystem : public IUpdateSystem {
 public:
-    // We initialize the system with the boundaries of our world.
-    CollisionSystem(const QuadtreeRect& worldBounds);
+    const char* getName() const override { return "CollisionSystem"; }
+    SystemAccess getAccess() const override;
+    // We initialize the system with the boundaries of our world and the broad phase to use.
+    CollisionSystem(const QuadtreeRect& worldBounds, BroadPhaseType broadPhaseType = BroadPhaseType::LinearQuadtree);
+
+    /**
+     * @brief Creates the broad phases, picking up the scene's BroadPhaseSettings, CollisionEventSettings
+     * and the engine's JobSystem from the context if present, and starts listening for static colliders being added or removed
+     * and for bodies falling asleep or waking up.
+     */
+    void init(entt::registry& registry) override;
+
+    /**
+     * @brief True if the collider never moves: it is flagged is_static, or it has no rigidbody or a STATIC one.
+     * Such colliders live in the persistent static broad phase and never initiate collision checks.
+     */
+    static bool isStaticCollider(const ColliderComponent& collider, const RigidBodyComponent* rigidbody);
 
     void update(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager, float deltaTime) override;
 
+    /**
+     * @brief Sets how many threads may run contact detection; 0 (the default) uses every JobSystem thread.
+     * Contacts are resolved in the same order whatever the count, so results don't depend on it.
+     */
+    void setDetectionThreadCount(unsigned threadCount) { m_detectionThreadCount = threadCount; }
+
 private:
-    std::unique_ptr<Quadtree<entt::entity>> m_quadtree;
+    /**
+     * @brief A static collider, or a sleeping body, as the narrow phase needs it. Neither moves
+     * on its own, so these are kept between ticks along with their broad phase.
+     */
+    struct StaticProxy {
+        entt::entity entity;
+        QuadtreeRect bounds;
+        uint32_t layer;
+        uint32_t mask;
+        bool isTrigger;
+    };
+
+    /**
+     * @brief A moving collider, gathered once per tick. Bounds are kept up to date as
+     * resolution moves the body, so candidates never have to be looked up in the registry.
+     */
+    struct DynamicProxy {
+        entt::entity entity;
+        QuadtreeRect bounds;
+        TransformComponent* transform;
+        RigidBodyComponent* rigidbody;
+        const ColliderComponent* collider;
+    };
+
+    // What a Contact's otherId indexes into.
+    enum class ContactKind : uint8_t {
+        Static,   // m_staticProxies
+        Sleeping, // m_sleepingProxies
+        Moving    // m_dynamicProxies
+    };
+
+    /**
+     * @brief A moving body (selfId) whose bounds overlapped a static collider, a sleeping body or
+     * a moving body with a higher id at the start of the tick, and whose layers and masks let them collide.
+     */
+    struct Contact {
+        BroadPhaseProxyId selfId;
+        BroadPhaseProxyId otherId;
+        ContactKind kind;
+    };
+
+    /**
+     * @brief One thread's share of contact detection: a contiguous range of moving bodies,
+     * its own query scratch and the contacts it found, ordered by body.
+     */
+    struct DetectionBatch {
+        BroadPhaseProxyId firstBody = 0;
+        BroadPhaseProxyId endBody = 0;
+        std::vector<BroadPhaseProxyId> staticCandidates;
+        std::vector<BroadPhaseProxyId> sleepingCandidates;
+        std::vector<Contact> contacts;
+    };
+
+    /**
+     * @brief Two entities that touched during a tick, as reported: `a` is the moving body.
+     * Sorted by key, which is the same whichever of the two reported the contact.
+     */
+    struct TouchingPair {
+        uint64_t key;
+        entt::entity a;
+        entt::entity b;
+
+        bool operator<(const TouchingPair& other) const { return key < other.key; }
+    };
+
+    // Fewer moving bodies than this per thread are not worth waking another thread for.
+    static constexpr size_t MIN_BODIES_PER_DETECTION_BATCH = 256;
+
+    QuadtreeRect m_worldBounds;
+    BroadPhaseType m_broadPhaseType;
+    // Static colliders: rebuilt only when a collider or rigidbody is added, changed or removed.
+    // Code that teleports a static collider must registry.patch<ColliderComponent>() it to be picked up.
+    std::unique_ptr<IBroadPhase> m_staticBroadPhase;
+    std::vector<StaticProxy> m_staticProxies;
+    bool m_isStaticBroadPhaseDirty = true;
+    // Sleeping bodies: only queried, like static colliders, and rebuilt whenever one falls asleep or wakes up.
+    std::unique_ptr<IBroadPhase> m_sleepingBroadPhase;
+    std::vector<StaticProxy> m_sleepingProxies;
+    bool m_isSleepingBroadPhaseDirty = true;
+    // Moving (dynamic/kinematic) colliders: rebuilt every tick.
+    std::unique_ptr<IBroadPhase> m_dynamicBroadPhase;
+    std::vector<DynamicProxy> m_dynamicProxies;
+    // Reused by every broad phase query so a tick does not allocate once it has warmed up.
+    std::vector<BroadPhaseProxyId> m_dynamicCandidates;
+    // Moving pairs whose bounds overlapped at the start of the tick, sorted.
+    std::vector<BroadPhasePair> m_dynamicPairs;
+    // All contacts of the tick in resolution order: by body, then statics, sleeping and moving bodies, each by id.
+    std::vector<Contact> m_contacts;
+    // Pairs that touched this tick and last tick, compared to report Begin/Stay/End events.
+    std::vector<TouchingPair> m_touchingPairs;
+    std::vector<TouchingPair> m_previousTouchingPairs;
+    // Last tick's pairs between two bodies that are now at rest; they still touch, nobody checks anymore.
+    std::vector<TouchingPair> m_restingTouchingPairs;
+    bool m_isReportingStay = false;
+
+    // --- Detection batches ---
+    // One per thread that may run detection, run as jobs on the engine's JobSystem.
+    // Without one (e.g. a system driven directly by a tool) everything runs on the updating thread.
+    JobSystem* m_jobSystem = nullptr;
+    unsigned m_detectionThreadCount = 0;
+    std::vector<DetectionBatch> m_detectionBatches;
+
+    void onStaticSetChanged(entt::registry& registry, entt::entity entity);
+    void onSleepingSetChanged(entt::registry& registry, entt::entity entity);
+    void rebuildStaticBroadPhase(entt::registry& registry);
+    void rebuildSleepingBroadPhase(entt::registry& registry);
+    void gatherDynamicProxies(entt::registry& registry);
+    void findDynamicPairs();
+
+    /**
+     * @brief Finds this tick's contacts into m_contacts, spreading the moving bodies over the detection threads.
+     * Only reads the proxies and broad phases; nothing is moved until resolveContacts().
+     */
+    void detectContacts();
+    void detectBatch(DetectionBatch& batch);
+
+    /**
+     * @brief Resolves m_contacts in order on the calling thread and records every pair that still
+     * overlaps when its turn comes in m_touchingPairs. A sleeping body that is hit wakes up.
+     */
+    void resolveContacts(entt::registry& registry, entt::entity tileGridEntity, const TileCollisionGridComponent* tileGrid);
+
+    void addTouchingPair(entt::entity a, entt::entity b);
+
+    /**
+     * @brief Compares this tick's touching pairs with last tick's and enqueues a Begin event for
+     * every new pair, an End event for every pair that is gone and, if enabled, a Stay event for the rest.
+     * A pair that went unchecked because neither side is an awake moving body any more is still touching.
+     */
+    void reportCollisionEvents(entt::registry& registry, entt::dispatcher& dispatcher);
+
+    /**
+     * @brief True if a touching pair that nobody checked this tick may still be touching from this side:
+     * the entity is alive and is either a sleeping or static collider, or the tile grid. Entities that lost
+     * their collider or are awake again are not, so their pairs end.
+     */
+    static bool isRestingContactSide(const entt::registry& registry, entt::entity entity);
+    BroadPhaseType getStaticBroadPhaseType() const;
 
     void dePenetrate(TransformComponent &dynamicTransform, const QuadtreeRect &dynamicBounds,
                        const QuadtreeRect &staticBounds);
@@ -27,6 +190,13 @@ private:
     void resolveStaticCollision(TransformComponent& dynamicTransform, const QuadtreeRect& dynamicBounds,
         const QuadtreeRect& staticBounds);
 
+    /**
+ * @brief Pushes a moving body out of the solid tiles it overlaps.
+ * @return True if it touched any, in which case the tilemap entity stands in for the wall it touched.
+ */
+    bool resolveTileGridCollision(TransformComponent& transform, const ColliderComponent& collider,
+        const TileCollisionGridComponent& grid);
+
     /**
  * @brief Resolves a collision between two dynamic entities.
  * This handles both positional depenetration and velocity changes (impulse) based on mass and restitution.
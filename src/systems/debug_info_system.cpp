@@ -3,6 +3,8 @@
 #include "../components/transform.hpp"
 #include "../components/collider.hpp"
 #include "../components/tilemap.hpp"
+#include "../core/context.hpp"
+#include "../core/profiler.hpp"
 #include <iostream>
 
 void DebugInfoSystem::dumpEntityColliderData(entt::registry &registry) {
@@ -74,10 +76,38 @@ void DebugInfoSystem::dumpTilemapComponentState(entt::registry &registry, Resour
     std::cout << "====================================================\n\n" << std::endl;
 }
 
+void DebugInfoSystem::dumpRenderStats(entt::registry &registry) {
+    if (!registry.ctx().contains<RenderStats>()) {
+        std::cout << "[DEBUG DUMP] No RenderStats found in scene context." << std::endl;
+        return;
+    }
+
+    const auto& stats = registry.ctx().get<RenderStats>();
+    std::cout << "\n\n================ RENDER STATS (last frame) =================" << std::endl;
+    std::cout << "  Visible:  " << stats.spritesVisible << std::endl;
+    std::cout << "  Culled:   " << stats.spritesCulled << std::endl;
+    std::cout << "  Batches:  " << stats.batches << std::endl;
+    std::cout << "  Vertices: " << stats.vertices << std::endl;
+    std::cout << "====================================================\n\n" << std::endl;
+}
+
+void DebugInfoSystem::dumpProfiler(entt::registry &registry) {
+    if (!registry.ctx().contains<FrameProfiler*>() || !registry.ctx().get<FrameProfiler*>()) {
+        std::cout << "[DEBUG DUMP] No FrameProfiler attached to this scene." << std::endl;
+        return;
+    }
+    registry.ctx().get<FrameProfiler*>()->dump(std::cout);
+}
+
 void DebugInfoSystem::update(entt::registry& registry, InputManager& inputManager,
                              ResourceManager& resourceManager, float deltaTime) {
+    if (inputManager.isActionJustPressed("dump_profiler")) {
+        dumpProfiler(registry);
+    }
+
     if (!inputManager.isActionJustPressed("dump_debug_info")) return;
 
     dumpTilemapComponentState(registry, resourceManager);
     dumpEntityColliderData(registry);
+    dumpRenderStats(registry);
 }
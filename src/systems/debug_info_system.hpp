@@ -7,12 +7,17 @@
 
 class DebugInfoSystem: public IUpdateSystem {
 public:
+    const char* getName() const override { return "DebugInfoSystem"; }
     DebugInfoSystem() = default;
 
     void dumpEntityColliderData(entt::registry &registry);
 
     void dumpTilemapComponentState(entt::registry &registry, ResourceManager &resourceManager);
 
+    void dumpRenderStats(entt::registry &registry);
+
+    void dumpProfiler(entt::registry &registry);
+
     void update(entt::registry& registry, InputManager& inputManager,
                 ResourceManager& resourceManager, float deltaTime) override;
 };
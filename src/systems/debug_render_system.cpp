@@ -2,18 +2,19 @@
 #include "../components/transform.hpp"
 #include "../components/collider.hpp"
 #include "../core/context.hpp"
+#include "../core/render_interpolation.hpp"
 #include "../util/quadtree.hpp" // For QuadtreeRect
 
 // We can re-use our helper function from the CollisionSystem
-static QuadtreeRect getDebugEntityBounds(const TransformComponent& transform, const ColliderComponent& collider) {
+static QuadtreeRect getDebugEntityBounds(const Vec2f& position, const TransformComponent& transform, const ColliderComponent& collider) {
     const float scaledWidth = collider.size.x * transform.scale.x;
     const float scaledHeight = collider.size.y * transform.scale.y;
     const float scaledOffsetX = collider.offset.x * transform.scale.x;
     const float scaledOffsetY = collider.offset.y * transform.scale.y;
 
     return {
-        static_cast<int>(transform.position.x - (scaledWidth / 2.0f) + scaledOffsetX),
-        static_cast<int>(transform.position.y - (scaledHeight / 2.0f) + scaledOffsetY),
+        static_cast<int>(position.x - (scaledWidth / 2.0f) + scaledOffsetX),
+        static_cast<int>(position.y - (scaledHeight / 2.0f) + scaledOffsetY),
         static_cast<int>(scaledWidth),
         static_cast<int>(scaledHeight)
     };
@@ -29,13 +30,17 @@ void DebugRenderSystem::draw(SDL_Renderer* renderer, entt::registry& registry, R
     const auto cameraEntity = registry.ctx().get<ActiveCamera>().entity;
     const auto& screen = registry.ctx().get<ScreenDimensions>();
     const auto& camTransform = registry.get<const TransformComponent>(cameraEntity);
-    const float cameraOffsetX = camTransform.position.x - screen.w / 2.0f;
-    const float cameraOffsetY = camTransform.position.y - screen.h / 2.0f;
+    // Draw where the sprites are drawn: blended between the last two simulation ticks.
+    const float alpha = getRenderInterpolationAlpha(registry);
+    const Vec2f cameraPos = getInterpolatedPosition(registry, cameraEntity, camTransform, alpha);
+    const float cameraOffsetX = cameraPos.x - screen.w / 2.0f;
+    const float cameraOffsetY = cameraPos.y - screen.h / 2.0f;
 
     for (const auto entity : view) {
         const auto& [transform, collider] = view.get<const TransformComponent, const ColliderComponent>(entity);
 
-        QuadtreeRect bounds = getDebugEntityBounds(transform, collider);
+        const Vec2f position = getInterpolatedPosition(registry, entity, transform, alpha);
+        QuadtreeRect bounds = getDebugEntityBounds(position, transform, collider);
         SDL_Rect debugRect = {
             bounds.x - static_cast<int>(cameraOffsetX),
             bounds.y - static_cast<int>(cameraOffsetY),
@@ -4,5 +4,6 @@
 
 class DebugRenderSystem : public IRenderSystem {
 public:
+    const char* getName() const override { return "DebugRenderSystem"; }
     void draw(SDL_Renderer* renderer, entt::registry& registry, ResourceManager& resourceManager) override;
 };
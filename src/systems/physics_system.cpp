@@ -1,37 +1,139 @@
 #include "physics_system.hpp"
 #include "../components/transform.hpp"
 #include "../components/rigidbody.hpp"
+#include "../core/trace.hpp"
+#include <algorithm>
+#include <limits>
 
-//TODO: how can we refactor or make cleaner the physic system now that is has more cases and is super more complex
-void PhysicsSystem::update(entt::registry& registry, InputManager&, ResourceManager&, float deltaTime) {
-    auto view = registry.view<TransformComponent, RigidBodyComponent>();
+SystemAccess PhysicsSystem::getAccess() const {
+    return SystemAccess{}.write<TransformComponent, RigidBodyComponent, SleepingComponent>();
+}
 
+void PhysicsSystem::init(entt::registry& registry) {
+    m_sleepSettings = PhysicsSleepSettings{};
+    if (registry.ctx().contains<PhysicsSleepSettings>()) {
+        m_sleepSettings = registry.ctx().get<PhysicsSleepSettings>();
+    }
+    // RigidBodyComponent::restTicks must be able to reach it.
+    m_sleepSettings.ticksToSleep = std::min<int>(m_sleepSettings.ticksToSleep, std::numeric_limits<uint16_t>::max());
+    m_areBodyListsDirty = true;
+
+    // Adding or removing either component may move the others in memory, so any of these
+    // invalidates the lists; rebuilt lazily, so loading a scene costs a single rebuild.
+    registry.on_construct<TransformComponent>().connect<&PhysicsSystem::onBodySetChanged>(this);
+    registry.on_destroy<TransformComponent>().connect<&PhysicsSystem::onBodySetChanged>(this);
+    registry.on_construct<RigidBodyComponent>().connect<&PhysicsSystem::onBodySetChanged>(this);
+    registry.on_update<RigidBodyComponent>().connect<&PhysicsSystem::onBodySetChanged>(this);
+    registry.on_destroy<RigidBodyComponent>().connect<&PhysicsSystem::onBodySetChanged>(this);
+    registry.on_construct<SleepingComponent>().connect<&PhysicsSystem::onBodySetChanged>(this);
+    registry.on_destroy<SleepingComponent>().connect<&PhysicsSystem::onBodySetChanged>(this);
+}
+
+void PhysicsSystem::onBodySetChanged(entt::registry&, entt::entity) {
+    m_areBodyListsDirty = true;
+}
+
+void PhysicsSystem::rebuildBodyLists(entt::registry& registry) {
+    TRACE_ZONE("PhysicsSystem::rebuildBodyLists");
+    m_dynamicBodies.clear();
+    m_kinematicBodies.clear();
+    auto view = registry.view<TransformComponent, RigidBodyComponent>(entt::exclude<SleepingComponent>);
     for (const auto entity : view) {
-        // Get each component individually to get mutable references.
-        auto& transform = view.get<TransformComponent>(entity);
-        auto& rigidbody = view.get<RigidBodyComponent>(entity);
+        auto [transform, rigidbody] = view.get<TransformComponent, RigidBodyComponent>(entity);
+        switch (rigidbody.bodyType) {
+            case BodyType::DYNAMIC: m_dynamicBodies.push_back(entity, transform, rigidbody); break;
+            case BodyType::KINEMATIC: m_kinematicBodies.push_back(entity, transform, rigidbody); break;
+            case BodyType::STATIC: break; // Static bodies don't move
+        }
+    }
+    m_areBodyListsDirty = false;
+}
 
-        if (rigidbody.bodyType == BodyType::STATIC) {
-            continue; // Static bodies don't move
+void PhysicsSystem::wakeDisturbedBodies(entt::registry& registry) {
+    m_changingBodies.clear();
+    auto sleepingView = registry.view<RigidBodyComponent, SleepingComponent>();
+    for (const auto entity : sleepingView) {
+        const auto& rigidbody = sleepingView.get<RigidBodyComponent>(entity);
+        const bool isDisturbed = rigidbody.force.x != 0.0f || rigidbody.force.y != 0.0f
+            || rigidbody.velocity.x != 0.0f || rigidbody.velocity.y != 0.0f;
+        if (isDisturbed) {
+            m_changingBodies.push_back(entity);
         }
-        if (rigidbody.bodyType == BodyType::DYNAMIC) {
-            // DYNAMIC bodies use the force integrator and damping
-            // 1. Apply forces to velocity (Integrate)
-            // Using mass: a = F/m.  v += a * dt
-            if (rigidbody.mass > 0.0f) {
-                rigidbody.velocity.x += (rigidbody.force.x / rigidbody.mass) * deltaTime;
-                rigidbody.velocity.y += (rigidbody.force.y / rigidbody.mass) * deltaTime;
-            }
-            //2. Apply damping
-            rigidbody.velocity.x *= rigidbody.damping;
-            rigidbody.velocity.y *= rigidbody.damping;
+    }
+    for (const auto entity : m_changingBodies) {
+        registry.get<RigidBodyComponent>(entity).restTicks = 0;
+        registry.remove<SleepingComponent>(entity);
+    }
+}
+
+void PhysicsSystem::integrateDynamicBodies(float deltaTime) {
+    const size_t count = m_dynamicBodies.size();
+    TransformComponent* const* transforms = m_dynamicBodies.transforms.data();
+    RigidBodyComponent* const* rigidbodies = m_dynamicBodies.rigidbodies.data();
+    // A zero threshold never counts a tick as resting, which keeps every body awake.
+    const float sleepSpeedSquared = m_sleepSettings.ticksToSleep > 0
+        ? m_sleepSettings.speedThreshold * m_sleepSettings.speedThreshold : 0.0f;
+    const int ticksToSleep = m_sleepSettings.ticksToSleep;
+
+    // Written without branches on body data, so mixed masses and speeds don't cost mispredictions.
+    for (size_t i = 0; i < count; ++i) {
+        TransformComponent& transform = *transforms[i];
+        RigidBodyComponent& rigidbody = *rigidbodies[i];
+
+        // 1. Apply forces to velocity (Integrate)
+        // Using mass: a = F/m.  v += a * dt. A zero mass is immovable: no acceleration.
+        const float accelerationScale = rigidbody.mass > 0.0f ? 1.0f / rigidbody.mass : 0.0f;
+        float velocityX = rigidbody.velocity.x + (rigidbody.force.x * accelerationScale) * deltaTime;
+        float velocityY = rigidbody.velocity.y + (rigidbody.force.y * accelerationScale) * deltaTime;
+        // 2. Apply damping
+        velocityX *= rigidbody.damping;
+        velocityY *= rigidbody.damping;
+        rigidbody.velocity = {velocityX, velocityY};
+
+        transform.position.x += velocityX * deltaTime;
+        transform.position.y += velocityY * deltaTime;
+
+        // 3. Clear forces for the next frame
+        rigidbody.force = {0.0f, 0.0f};
+
+        // 4. Rest detection: count consecutive slow ticks, back to zero as soon as the body speeds up.
+        const bool isResting = rigidbody.canSleep && velocityX * velocityX + velocityY * velocityY < sleepSpeedSquared;
+        rigidbody.restTicks = static_cast<uint16_t>((rigidbody.restTicks + 1) * isResting);
+        if (rigidbody.restTicks >= ticksToSleep && isResting) {
+            m_changingBodies.push_back(m_dynamicBodies.entities[i]);
         }
+    }
+}
 
-        // For BOTH KINEMATIC and DYNAMIC, we apply the final velocity to the position.
+void PhysicsSystem::integrateKinematicBodies(float deltaTime) {
+    const size_t count = m_kinematicBodies.size();
+    TransformComponent* const* transforms = m_kinematicBodies.transforms.data();
+    RigidBodyComponent* const* rigidbodies = m_kinematicBodies.rigidbodies.data();
+    for (size_t i = 0; i < count; ++i) {
+        TransformComponent& transform = *transforms[i];
+        RigidBodyComponent& rigidbody = *rigidbodies[i];
         transform.position.x += rigidbody.velocity.x * deltaTime;
         transform.position.y += rigidbody.velocity.y * deltaTime;
-
-        // 3. Clear forces for the next frame
         rigidbody.force = {0.0f, 0.0f};
     }
 }
+
+void PhysicsSystem::update(entt::registry& registry, InputManager&, ResourceManager&, float deltaTime) {
+    // Sleeping bodies cost one check each here and nothing anywhere else.
+    wakeDisturbedBodies(registry);
+    if (m_areBodyListsDirty) {
+        rebuildBodyLists(registry);
+    }
+
+    m_changingBodies.clear();
+    integrateDynamicBodies(deltaTime);
+    integrateKinematicBodies(deltaTime);
+
+    for (const auto entity : m_changingBodies) {
+        // Whatever speed is left is dropped, so the body doesn't creep while nothing simulates it.
+        auto& rigidbody = registry.get<RigidBodyComponent>(entity);
+        rigidbody.velocity = {0.0f, 0.0f};
+        rigidbody.restTicks = 0;
+        registry.emplace<SleepingComponent>(entity);
+    }
+}
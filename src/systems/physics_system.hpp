@@ -1,8 +1,75 @@
 #pragma once
 
 #include "../core/systems/isystem.hpp"
+#include "../core/context.hpp"
+#include <vector>
+
+struct TransformComponent;
+struct RigidBodyComponent;
 
 class PhysicsSystem : public IUpdateSystem {
 public:
+    const char* getName() const override { return "PhysicsSystem"; }
+    SystemAccess getAccess() const override;
+
+    /**
+     * @brief Picks up the scene's PhysicsSleepSettings from the context if present, and starts
+     * listening for bodies being added, removed, changing type, falling asleep or waking up.
+     */
+    void init(entt::registry& registry) override;
     void update(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager, float deltaTime) override;
+
+private:
+    /**
+     * @brief The awake bodies of one BodyType, as dense arrays in registry iteration order.
+     * Component pointers stay valid until a TransformComponent or RigidBodyComponent is added or
+     * removed anywhere, which marks the lists dirty.
+     */
+    struct BodyList {
+        std::vector<entt::entity> entities;
+        std::vector<TransformComponent*> transforms;
+        std::vector<RigidBodyComponent*> rigidbodies;
+
+        size_t size() const { return entities.size(); }
+
+        void clear() {
+            entities.clear();
+            transforms.clear();
+            rigidbodies.clear();
+        }
+
+        void push_back(entt::entity entity, TransformComponent& transform, RigidBodyComponent& rigidbody) {
+            entities.push_back(entity);
+            transforms.push_back(&transform);
+            rigidbodies.push_back(&rigidbody);
+        }
+    };
+
+    PhysicsSleepSettings m_sleepSettings;
+    // Awake bodies sorted by type, so each type is integrated in its own pass without a type check per body.
+    // Code that changes a body's type must registry.patch<RigidBodyComponent>() it to be picked up.
+    BodyList m_dynamicBodies;
+    BodyList m_kinematicBodies;
+    bool m_areBodyListsDirty = true;
+    // Reused every tick: bodies that change state are collected first, since adding or removing
+    // SleepingComponent while iterating a view that excludes it would disturb the iteration.
+    std::vector<entt::entity> m_changingBodies;
+
+    void onBodySetChanged(entt::registry& registry, entt::entity entity);
+    void rebuildBodyLists(entt::registry& registry);
+
+    /**
+     * @brief Wakes every sleeping body that was given a force or velocity since it fell asleep.
+     */
+    void wakeDisturbedBodies(entt::registry& registry);
+
+    /**
+     * @brief Applies force and damping, moves, and counts rest ticks; bodies ready to sleep go to m_changingBodies.
+     */
+    void integrateDynamicBodies(float deltaTime);
+
+    /**
+     * @brief Moves by the velocity game code set; forces don't apply to kinematic bodies.
+     */
+    void integrateKinematicBodies(float deltaTime);
 };
@@ -6,6 +6,10 @@
 #include "../components/movement.hpp"
 #include <iostream>
 
+SystemAccess PlayerIntentSystem::getAccess() const {
+    return SystemAccess{}.readResource<InputManager>().read<PlayerControlComponent>().write<IntentComponent>();
+}
+
 void PlayerIntentSystem::update(entt::registry& registry, InputManager& inputManager,
     ResourceManager& resourceManager, float deltaTime) {
     auto view = registry.view<PlayerControlComponent, IntentComponent>();
@@ -5,6 +5,8 @@
 
 class PlayerIntentSystem: public IUpdateSystem {
 public:
+    const char* getName() const override { return "PlayerIntentSystem"; }
+    SystemAccess getAccess() const override;
     PlayerIntentSystem() = default;
 
     void update(entt::registry& registry, InputManager& inputManager,
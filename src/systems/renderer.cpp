@@ -2,6 +2,7 @@
 #include "../components/transform.hpp"
 #include "../components/sprite.hpp"
 #include  "../core/context.hpp"
+#include "../core/render_interpolation.hpp"
 #include "../util/resource_manager.hpp"
 #include "../util/sprite_asset.hpp"
 #include <iostream>
@@ -35,6 +36,37 @@ void RenderSystem::init(entt::registry& registry) {
     registry.on_construct<SpriteComponent>().connect<&RenderSystem::onSpriteUpdate>(this);
     registry.on_update<SpriteComponent>().connect<&RenderSystem::onSpriteUpdate>(this);
     registry.on_destroy<SpriteComponent>().connect<&RenderSystem::onSpriteUpdate>(this);
+
+    // Expose the per-frame counters so they can be inspected from outside the system.
+    registry.ctx().emplace<RenderStats>();
+}
+
+void RenderSystem::appendQuad(const SDL_FRect& destRect, float u0, float v0, float u1, float v1, SDL_Color color) {
+    const int base = static_cast<int>(m_batchVertices.size());
+
+    m_batchVertices.push_back({{destRect.x, destRect.y}, color, {u0, v0}});
+    m_batchVertices.push_back({{destRect.x + destRect.w, destRect.y}, color, {u1, v0}});
+    m_batchVertices.push_back({{destRect.x + destRect.w, destRect.y + destRect.h}, color, {u1, v1}});
+    m_batchVertices.push_back({{destRect.x, destRect.y + destRect.h}, color, {u0, v1}});
+
+    // Two triangles per quad: (0, 1, 2) and (2, 3, 0).
+    m_batchIndices.insert(m_batchIndices.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+}
+
+void RenderSystem::flushBatch(SDL_Renderer* renderer, SDL_Texture* texture, RenderStats& stats) {
+    if (m_batchVertices.empty()) {
+        return;
+    }
+
+    SDL_RenderGeometry(renderer, texture,
+        m_batchVertices.data(), static_cast<int>(m_batchVertices.size()),
+        m_batchIndices.data(), static_cast<int>(m_batchIndices.size()));
+
+    stats.batches++;
+    stats.vertices += static_cast<int>(m_batchVertices.size());
+
+    m_batchVertices.clear();
+    m_batchIndices.clear();
 }
 
 void RenderSystem::draw(SDL_Renderer* renderer, entt::registry& registry,
@@ -74,20 +106,60 @@ void RenderSystem::draw(SDL_Renderer* renderer, entt::registry& registry,
     // --- Camera calculation ---
     const auto& screen = registry.ctx().get<ScreenDimensions>();
     const auto& camTransform = registry.get<const TransformComponent>(cameraEntity);
-    Vec2f cameraPos = camTransform.position;
+    // Positions are blended between the last two simulation ticks (see RenderInterpolation).
+    const float alpha = getRenderInterpolationAlpha(registry);
+    Vec2f cameraPos = getInterpolatedPosition(registry, cameraEntity, camTransform, alpha);
     // The camera's position is its top-left corner in the world.
     // To center the view on the camera's anchor point, we offset by half the screen size.
     const float cameraOffsetX = cameraPos.x - screen.w / 2.0f;
     const float cameraOffsetY = cameraPos.y - screen.h / 2.0f;
 
     // --- DRAW ---
-    // Iterate over each entity in the view
+    // Sprites outside the camera view are culled first.
+    // Consecutive entries of the (sorted) render queue that share an atlas texture are
+    // accumulated into one vertex/index buffer and submitted together. A new batch only
+    // starts when the texture changes, so the sortKey order is preserved.
+    auto& stats = registry.ctx().get<RenderStats>();
+    stats = RenderStats{};
+
+    SDL_Texture* batchTexture = nullptr;
     for (const auto entity : m_renderQueue) {
         // Get the components from the renderable's entity
         const auto& transform = registry.get<const TransformComponent>(entity);
-        const auto& sprite = registry.get<const SpriteComponent>(entity);
+        auto& sprite = registry.get<SpriteComponent>(entity);
 
-        const SpriteAsset* asset = resourceManager.getSpriteAsset(sprite.assetId);
+        const float scaledWidth = static_cast<float>(sprite.width) * transform.scale.x;
+        const float scaledHeight = static_cast<float>(sprite.height) * transform.scale.y;
+        const Vec2f position = getInterpolatedPosition(registry, entity, transform, alpha);
+
+        // Use component data to define where and how to draw the sprite
+        // To draw a sprite centered on the transform's position, we must
+        // offset the top-left drawing corner by half of the sprite's scaled size.
+        const SDL_FRect destRect = {
+            position.x - (scaledWidth / 2.0f) - cameraOffsetX,
+            position.y - (scaledHeight / 2.0f) - cameraOffsetY,
+            scaledWidth,
+            scaledHeight
+        };
+
+        // --- View-Frustum Culling ---
+        // Reject sprites whose scaled bounds do not touch the screen before any asset
+        // lookup or texture state is involved. Scale may be negative (mirroring),
+        // so normalize the extent first.
+        const float left = std::min(destRect.x, destRect.x + destRect.w);
+        const float right = std::max(destRect.x, destRect.x + destRect.w);
+        const float top = std::min(destRect.y, destRect.y + destRect.h);
+        const float bottom = std::max(destRect.y, destRect.y + destRect.h);
+        if (right <= 0.0f || left >= screen.w || bottom <= 0.0f || top >= screen.h) {
+            stats.spritesCulled++;
+            continue;
+        }
+
+        if (sprite.assetHandle == INVALID_SPRITE_ASSET_HANDLE) {
+            sprite.assetHandle = resourceManager.getSpriteAssetHandle(sprite.assetId);
+        }
+
+        const SpriteAsset* asset = resourceManager.getSpriteAsset(sprite.assetHandle);
         if (!asset) {
             std::cerr << "RenderSystem::draw - Asset not found for id: " << sprite.assetId << std::endl;
             continue;
@@ -101,41 +173,34 @@ void RenderSystem::draw(SDL_Renderer* renderer, entt::registry& registry,
 
         // --- Calculate Source Rectangle ---
         int frameIndexInAtlas = 0; // 0 if anything fails
-        // Find the animation sequence for the sprite's current state
-        auto anim_it = asset->animations.find(sprite.currentState);
-        if (anim_it != asset->animations.end()) {
-            const AnimationSequence& sequence = anim_it->second;
+        // Get the animation sequence for the sprite's current state (cached until the state changes)
+        if (const AnimationSequence* sequence = sprite.resolveSequence(*asset)) {
             // Ensure the currentFrame index is valid for the sequence
-            if (!sequence.empty() && sprite.currentFrame < sequence.size()) {
+            if (!sequence->empty() && sprite.currentFrame < sequence->size()) {
                 // Get the correct frame index from the animation data
-                frameIndexInAtlas = sequence[sprite.currentFrame].frameIndexInAtlas;
+                frameIndexInAtlas = (*sequence)[sprite.currentFrame].frameIndexInAtlas;
             }
         }
 
         // This selects which frame to draw from the atlas.
-        // We assume all frames are laid out horizontally.
-        const SDL_Rect srcRect = {
-            frameIndexInAtlas * sprite.width,   // x position in the atlas
-            0,                                  // y position (0 if all in one row)
-            sprite.width,                       // width of one frame
-            sprite.height                       // height of one frame
-        };
-
-        const float scaledWidth = static_cast<float>(sprite.width) * transform.scale.x;
-        const float scaledHeight = static_cast<float>(sprite.height) * transform.scale.y;
-
-        // Use component data to define where and how to draw the sprite
-        // To draw a sprite centered on the transform's position, we must
-        // offset the top-left drawing corner by half of the sprite's scaled size.
-        const SDL_FRect destRect = {
-            transform.position.x - (scaledWidth / 2.0f) - cameraOffsetX,
-            transform.position.y - (scaledHeight / 2.0f) - cameraOffsetY,
-            scaledWidth,
-            scaledHeight
-        };
+        // We assume all frames are laid out horizontally, so the texture coordinates
+        // are the frame rectangle normalized by the atlas size.
+        const float atlasWidth = static_cast<float>(asset->atlasWidth);
+        const float atlasHeight = static_cast<float>(asset->atlasHeight);
+        const float u0 = static_cast<float>(frameIndexInAtlas * sprite.width) / atlasWidth;
+        const float u1 = static_cast<float>((frameIndexInAtlas + 1) * sprite.width) / atlasWidth;
+        const float v0 = 0.0f;
+        const float v1 = static_cast<float>(sprite.height) / atlasHeight;
+
+        // A texture change breaks the batch.
+        if (texture != batchTexture) {
+            flushBatch(renderer, batchTexture, stats);
+            batchTexture = texture;
+        }
 
-        SDL_SetTextureColorMod(texture, sprite.color.r, sprite.color.g, sprite.color.b);
-        SDL_SetTextureAlphaMod(texture, sprite.color.a);
-        SDL_RenderCopyF(renderer, texture, &srcRect, &destRect);
+        appendQuad(destRect, u0, v0, u1, v1, sprite.color);
+        stats.spritesVisible++;
     }
+
+    flushBatch(renderer, batchTexture, stats);
 }
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "../core/systems/isystem.hpp"
+#include <vector>
+
+struct RenderStats;
 
 class RenderSystem: public IRenderSystem{
 public:
+    const char* getName() const override { return "RenderSystem"; }
     RenderSystem() = default;
 
     void init(entt::registry& registry) override;
@@ -13,8 +17,25 @@ public:
 private:
     // signal listener.
     void onSpriteUpdate(entt::registry& registry, entt::entity entity);
+
+    /**
+     * @brief Appends one textured quad to the current batch.
+     * The sprite tint is baked into the vertex color instead of the texture color mod,
+     * so sprites with different tints can still share a single draw call.
+     */
+    void appendQuad(const SDL_FRect& destRect, float u0, float v0, float u1, float v1, SDL_Color color);
+
+    /**
+     * @brief Submits the current batch with a single SDL_RenderGeometry call and resets it.
+     */
+    void flushBatch(SDL_Renderer* renderer, SDL_Texture* texture, RenderStats& stats);
+
     // A persistent, sorted list of entities to render
     std::vector<entt::entity> m_renderQueue;
     // The flag to control when we re-sort
     bool m_isDirty = true;
+
+    // Geometry of the batch being built. Kept as members so their capacity is reused between frames.
+    std::vector<SDL_Vertex> m_batchVertices;
+    std::vector<int> m_batchIndices;
 };
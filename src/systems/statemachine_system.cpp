@@ -1,70 +1,113 @@
 #include "statemachine_system.hpp"
 #include "../components/statemachine/statemachine.hpp"
 #include "../components/blackboard.hpp"
+#include "../components/sprite.hpp"
 #include "../core/blackboard_keys.hpp"
+#include "../core/job_system.hpp"
 #include <entt/entt.hpp>
+#include <algorithm>
 
 using namespace entt::literals;
 
+SystemAccess StateMachineSystem::getAccess() const {
+    return SystemAccess{}.read<BlackboardComponent>().write<StateMachineComponent, SpriteComponent>();
+}
+
+void StateMachineSystem::init(entt::registry& registry) {
+    m_jobSystem = registry.ctx().contains<JobSystem*>() ? registry.ctx().get<JobSystem*>() : nullptr;
+}
+
 void StateMachineSystem::update(entt::registry& registry, InputManager&, ResourceManager&, float deltaTime) {
     auto view = registry.view<StateMachineComponent, const BlackboardComponent>();
-
+    m_machines.clear();
     for (const auto entity : view) {
-        auto& fsm = view.get<StateMachineComponent>(entity);
-        const auto& blackboard = view.get<const BlackboardComponent>(entity);
+        m_machines.push_back({entity, &view.get<StateMachineComponent>(entity), &view.get<const BlackboardComponent>(entity)});
+    }
 
-        // --- 1. Check for a valid transition ---
-        entt::hashed_string nextStateKey{""_hs};
+    const size_t jobCount = std::max<size_t>(1, (m_machines.size() + MACHINES_PER_JOB - 1) / MACHINES_PER_JOB);
+    if (m_stateChanges.size() < jobCount) {
+        m_stateChanges.resize(jobCount);
+    }
+    // Cleared here rather than by the jobs: with no machines no job runs, and last tick's
+    // changes would point into components that may be gone.
+    for (auto& stateChanges : m_stateChanges) {
+        stateChanges.clear();
+    }
+
+    // --- 1. Check for a valid transition, or update the current state (in parallel) ---
+    const auto advanceRange = [&](size_t begin, size_t end) {
+        auto& stateChanges = m_stateChanges[begin / MACHINES_PER_JOB];
+        for (size_t i = begin; i < end; ++i) {
+            const Machine& machine = m_machines[i];
+            auto& fsm = *machine.fsm;
 
-        // Find the list of possible transitions from the current state in the TRANSITIONS map.
-        if (auto it = fsm.transitions.find(fsm.currentState); it != fsm.transitions.end()) {
-            const auto& transitionsForState = it->second;
-            for (const auto& transition : transitionsForState) {
-                bool allConditionsMet = true;
-                // Check all conditions for this transition.
-                for (const auto& condition : transition.conditions) {
-                    bool conditionMet = false;
-                    if (auto bb_it = blackboard.values.find(condition.blackboardKey); bb_it != blackboard.values.end()) {
-                        // Check if the blackboard value matches the condition's expected value.
-                        if (const bool* value = std::any_cast<bool>(&bb_it->second)) {
-                            if (*value == condition.expectedValue) {
-                                conditionMet = true;
-                            }
-                        }
-                    }
-                    // If any condition is not met, this transition is invalid.
-                    if (!conditionMet) {
-                        allConditionsMet = false;
-                        break;
-                    }
-                }
+            const entt::hashed_string nextStateKey = findTransition(fsm, *machine.blackboard);
+            if (nextStateKey != ""_hs && nextStateKey != fsm.currentState) {
+                // onExit/onEnter may touch other entities: leave them for the serial pass below.
+                stateChanges.push_back({machine.entity, machine.fsm, nextStateKey});
+                continue;
+            }
 
-                if (allConditionsMet) {
-                    nextStateKey = transition.toState;
-                    break; // Found a valid transition, stop checking others.
-                }
+            fsm.timeInState += deltaTime;
+            if (auto currentStateIt = fsm.states.find(fsm.currentState); currentStateIt != fsm.states.end()) {
+                currentStateIt->second->onUpdate(machine.entity, registry, deltaTime);
             }
         }
+    };
+    if (m_jobSystem) {
+        m_jobSystem->parallelFor("StateMachineSystem::advance", m_machines.size(), MACHINES_PER_JOB, advanceRange);
+    } else {
+        advanceRange(0, m_machines.size());
+    }
 
-        // --- 2. Perform State Change if Needed ---
-        if (nextStateKey != ""_hs && nextStateKey != fsm.currentState) {
+    // --- 2. Perform the queued state changes, then update the new state ---
+    for (size_t job = 0; job < jobCount; ++job) {
+        for (const auto& change : m_stateChanges[job]) {
+            auto& fsm = *change.fsm;
             if (auto oldStateIt = fsm.states.find(fsm.currentState); oldStateIt != fsm.states.end()) {
-                oldStateIt->second->onExit(entity, registry);
+                oldStateIt->second->onExit(change.entity, registry);
             }
 
             fsm.previousState = fsm.currentState;
-            fsm.currentState = nextStateKey;
+            fsm.currentState = change.toState;
             fsm.timeInState = 0.0f;
 
             if (auto newStateIt = fsm.states.find(fsm.currentState); newStateIt != fsm.states.end()) {
-                newStateIt->second->onEnter(entity, registry);
+                newStateIt->second->onEnter(change.entity, registry);
+            }
+
+            fsm.timeInState += deltaTime;
+            if (auto currentStateIt = fsm.states.find(fsm.currentState); currentStateIt != fsm.states.end()) {
+                currentStateIt->second->onUpdate(change.entity, registry, deltaTime);
+            }
+        }
+    }
+}
+
+entt::hashed_string StateMachineSystem::findTransition(const StateMachineComponent& fsm, const BlackboardComponent& blackboard) {
+    // Find the list of possible transitions from the current state in the TRANSITIONS map.
+    auto it = fsm.transitions.find(fsm.currentState);
+    if (it == fsm.transitions.end()) {
+        return ""_hs;
+    }
+
+    for (const auto& transition : it->second) {
+        bool allConditionsMet = true;
+        // Check all conditions for this transition.
+        for (const auto& condition : transition.conditions) {
+            // Check if the blackboard value matches the condition's expected value.
+            const bool* value = blackboard.get<bool>(condition.blackboardKey);
+            const bool conditionMet = value && *value == condition.expectedValue;
+            // If any condition is not met, this transition is invalid.
+            if (!conditionMet) {
+                allConditionsMet = false;
+                break;
             }
         }
 
-        // --- 3. Update the Current State ---
-        fsm.timeInState += deltaTime;
-        if (auto currentStateIt = fsm.states.find(fsm.currentState); currentStateIt != fsm.states.end()) {
-            currentStateIt->second->onUpdate(entity, registry, deltaTime);
+        if (allConditionsMet) {
+            return transition.toState; // Found a valid transition, stop checking others.
         }
     }
-}
\ No newline at end of file
+    return ""_hs;
+}
@@ -4,9 +4,60 @@
 #include "../core/input_manager.hpp"
 #include "../util/resource_manager.hpp"
 #include "../core/entt_helpers.hpp"
+#include <vector>
+
+class JobSystem;
+struct StateMachineComponent;
+struct BlackboardComponent;
 
 class StateMachineSystem : public IUpdateSystem {
 public:
+    const char* getName() const override { return "StateMachineSystem"; }
+    /**
+     * @note States run inside update(), so their onEnter/onUpdate/onExit may only touch what is
+     * declared here (SpriteComponents, as SimpleAnimationState does). See IState for which of
+     * them may touch other entities.
+     */
+    SystemAccess getAccess() const override;
+
+    /**
+     * @brief Picks up the engine's JobSystem from the context if present, to advance machines in parallel.
+     */
+    void init(entt::registry& registry) override;
+
+    /**
+     * @brief Advances every state machine. Transitions are checked and onUpdate() runs for all machines
+     * in parallel; the state changes found are queued and applied afterwards on one thread, in entity
+     * order, so onExit()/onEnter() can safely touch other entities.
+     */
     void update(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager,
         float deltaTime) override;
+
+private:
+    struct Machine {
+        entt::entity entity;
+        StateMachineComponent* fsm;
+        const BlackboardComponent* blackboard;
+    };
+
+    // A transition found by the parallel pass, waiting to be applied.
+    struct StateChange {
+        entt::entity entity;
+        StateMachineComponent* fsm;
+        entt::hashed_string toState;
+    };
+
+    // Machines per job; each machine only depends on itself during the parallel pass.
+    static constexpr size_t MACHINES_PER_JOB = 256;
+
+    JobSystem* m_jobSystem = nullptr;
+    // Reused every tick: the machines, collected before the parallel pass.
+    std::vector<Machine> m_machines;
+    // One command buffer per job so jobs never share one; applied in job order, which is entity order.
+    std::vector<std::vector<StateChange>> m_stateChanges;
+
+    /**
+     * @brief The state the first transition whose conditions all hold leads to, or ""_hs if none does.
+     */
+    static entt::hashed_string findTransition(const StateMachineComponent& fsm, const BlackboardComponent& blackboard);
 };
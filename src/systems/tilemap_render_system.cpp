@@ -3,10 +3,134 @@
 #include "../components/camera.hpp"
 #include "../components/transform.hpp"
 #include "../core/context.hpp"
+#include "../core/render_interpolation.hpp"
 #include "../util/resource_manager.hpp"
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 
+void TilemapRenderSystem::init(entt::registry& registry) {
+    registry.on_construct<TilemapComponent>().connect<&TilemapRenderSystem::onTilemapChanged>(this);
+    // replace()/patch() swap in a whole map whose revisions say nothing about what it held before.
+    registry.on_update<TilemapComponent>().connect<&TilemapRenderSystem::onTilemapChanged>(this);
+    registry.on_destroy<TilemapComponent>().connect<&TilemapRenderSystem::onTilemapChanged>(this);
+}
+
+void TilemapRenderSystem::onTilemapChanged(entt::registry&, entt::entity) {
+    invalidateChunks();
+}
+
+void TilemapRenderSystem::invalidateChunks() {
+    m_cachedTilemap = entt::null;
+    m_chunks.clear();
+}
+
+bool TilemapRenderSystem::bakeChunk(SDL_Renderer* renderer, const TilemapComponent& tilemap,
+        const TilesetAsset& tileset, int chunkCol, int chunkRow, Chunk& chunk) {
+    constexpr int chunkSize = TilemapComponent::CHUNK_SIZE_IN_TILES;
+    const int firstCol = chunkCol * chunkSize;
+    const int firstRow = chunkRow * chunkSize;
+    // Chunks on the right/bottom edge of the map may be smaller than a full chunk.
+    const int colsInChunk = std::min(chunkSize, tilemap.getWidthInTiles() - firstCol);
+    const int rowsInChunk = std::min(chunkSize, tilemap.getHeightInTiles() - firstRow);
+
+    if (!chunk.texture) {
+        SDL_Texture* rawTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+            colsInChunk * tilemap.tileWidth, rowsInChunk * tilemap.tileHeight);
+        if (!rawTexture) {
+            std::cerr << "TilemapRenderSystem: Failed to create chunk texture: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        SDL_SetTextureBlendMode(rawTexture, SDL_BLENDMODE_BLEND);
+        chunk.texture.reset(rawTexture);
+    }
+
+    // Redirect drawing into the chunk texture, preserving the caller's target and draw color.
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+    if (SDL_SetRenderTarget(renderer, chunk.texture.get()) != 0) {
+        std::cerr << "TilemapRenderSystem: Failed to bind chunk render target: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0); // Fully transparent, empty tiles stay see-through.
+    SDL_RenderClear(renderer);
+
+    SDL_Texture* atlas = tileset.textureAtlas.get();
+    for (const auto& layer : tilemap.layers) {
+        for (int row = firstRow; row < firstRow + rowsInChunk && row < layer.heightInTiles; ++row) {
+            for (int col = firstCol; col < firstCol + colsInChunk && col < layer.widthInTiles; ++col) {
+                int tileId = layer.tileIds[row * layer.widthInTiles + col];
+                if (tileId == 0) continue; // 0 is an empty tile
+
+                int tileIndex = tileId - 1; // Map IDs are 1-based, array indices are 0-based
+
+                int srcX = (tileIndex % tileset.columns) * tileset.tileWidth;
+                int srcY = (tileIndex / tileset.columns) * tileset.tileHeight;
+                SDL_Rect srcRect = {srcX, srcY, tileset.tileWidth, tileset.tileHeight};
+
+                // Destination is relative to the chunk's top-left corner.
+                SDL_Rect destRect = {
+                    (col - firstCol) * tilemap.tileWidth,
+                    (row - firstRow) * tilemap.tileHeight,
+                    tilemap.tileWidth,
+                    tilemap.tileHeight
+                };
+                SDL_RenderCopy(renderer, atlas, &srcRect, &destRect);
+            }
+        }
+    }
+
+    SDL_SetRenderTarget(renderer, previousTarget);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+
+    chunk.bakedRevision = tilemap.getChunkRevision(chunkCol, chunkRow);
+    chunk.isBaked = true;
+    return true;
+}
+
+void TilemapRenderSystem::drawVisibleTiles(SDL_Renderer* renderer, const TilemapComponent& tilemap,
+        const TilesetAsset& tileset, float cameraLeft, float cameraTop, float viewWidth, float viewHeight) {
+    // Determine which tiles are visible
+    const int startCol = std::max(0, static_cast<int>(std::floor(cameraLeft / tilemap.tileWidth)));
+    const int startRow = std::max(0, static_cast<int>(std::floor(cameraTop / tilemap.tileHeight)));
+    const int endCol = std::min(tilemap.getWidthInTiles(), static_cast<int>(std::floor((cameraLeft + viewWidth - 1) / tilemap.tileWidth) + 1));
+    const int endRow = std::min(tilemap.getHeightInTiles(), static_cast<int>(std::floor((cameraTop + viewHeight - 1) / tilemap.tileHeight) + 1));
+    drawTiles(renderer, tilemap, tileset, startCol, startRow, endCol, endRow, cameraLeft, cameraTop);
+}
+
+void TilemapRenderSystem::drawTiles(SDL_Renderer* renderer, const TilemapComponent& tilemap, const TilesetAsset& tileset,
+        int startCol, int startRow, int endCol, int endRow, float cameraLeft, float cameraTop) {
+    SDL_Texture* texture = tileset.textureAtlas.get();
+
+    // Draw each tile in the range from each layer
+    for (const auto& layer : tilemap.layers) {
+        for (int row = startRow; row < endRow && row < layer.heightInTiles; ++row) {
+            for (int col = startCol; col < endCol && col < layer.widthInTiles; ++col) {
+                int tileId = layer.tileIds[row * layer.widthInTiles + col];
+                if (tileId == 0) continue; // 0 is an empty tile
+
+                int tileIndex = tileId - 1; // Map IDs are 1-based, array indices are 0-based
+
+                // Calculate source rect from the tileset atlas
+                int srcX = (tileIndex % tileset.columns) * tileset.tileWidth;
+                int srcY = (tileIndex / tileset.columns) * tileset.tileHeight;
+                SDL_Rect srcRect = {srcX, srcY, tileset.tileWidth, tileset.tileHeight};
+
+                // Calculate destination rect using integer coordinates for pixel-perfect drawing.
+                SDL_Rect destRect = {
+                    static_cast<int>(std::round((col * tilemap.tileWidth) - cameraLeft)),
+                    static_cast<int>(std::round((row * tilemap.tileHeight) - cameraTop)),
+                    tilemap.tileWidth,
+                    tilemap.tileHeight
+                };
+                SDL_RenderCopy(renderer, texture, &srcRect, &destRect);
+            }
+        }
+    }
+}
+
 void TilemapRenderSystem::draw(SDL_Renderer* renderer, entt::registry& registry,
         ResourceManager& resourceManager) {
     // There should only be one tilemap entity, find it.
@@ -16,6 +140,9 @@ void TilemapRenderSystem::draw(SDL_Renderer* renderer, entt::registry& registry,
     }
     entt::entity tilemapEntity = mapView.front();
     const auto& tilemap = mapView.get<TilemapComponent>(tilemapEntity);
+    if (tilemap.layers.empty() || tilemap.tileWidth <= 0 || tilemap.tileHeight <= 0) {
+        return;
+    }
 
     // Get the tileset asset
     const TilesetAsset* tileset = resourceManager.getTilesetAsset(tilemap.tilesetAssetId);
@@ -30,40 +157,62 @@ void TilemapRenderSystem::draw(SDL_Renderer* renderer, entt::registry& registry,
 
     const auto& screen = registry.ctx().get<ScreenDimensions>();
     const auto& camTransform = registry.get<const TransformComponent>(cameraEntity);
-    const float cameraLeft = camTransform.position.x - screen.w / 2.0f;
-    const float cameraTop = camTransform.position.y - screen.h / 2.0f;
-
-    // Determine which tiles are visible
-    const int startCol = std::max(0, static_cast<int>(std::floor(cameraLeft / tilemap.tileWidth)));
-    const int startRow = std::max(0, static_cast<int>(std::floor(cameraTop / tilemap.tileHeight)));
-    const int endCol = std::min(tilemap.layers[0].widthInTiles, static_cast<int>(std::floor((cameraLeft + screen.w - 1) / tilemap.tileWidth) + 1));
-    const int endRow = std::min(tilemap.layers[0].heightInTiles, static_cast<int>(std::floor((cameraTop + screen.h - 1) / tilemap.tileHeight) + 1));
+    const Vec2f cameraPos = getInterpolatedPosition(registry, cameraEntity, camTransform,
+        getRenderInterpolationAlpha(registry));
+    const float cameraLeft = cameraPos.x - screen.w / 2.0f;
+    const float cameraTop = cameraPos.y - screen.h / 2.0f;
 
-    SDL_Texture* texture = tileset->textureAtlas.get();
-    
-    // Draw each visible tile from each layer
-    for (const auto& layer : tilemap.layers) {
-        for (int row = startRow; row < endRow; ++row) {
-            for (int col = startCol; col < endCol; ++col) {
-                int tileId = layer.tileIds[row * layer.widthInTiles + col];
-                if (tileId == 0) continue; // 0 is an empty tile
+    if (!SDL_RenderTargetSupported(renderer)) {
+        drawVisibleTiles(renderer, tilemap, *tileset, cameraLeft, cameraTop, screen.w, screen.h);
+        return;
+    }
 
-                int tileIndex = tileId - 1; // Map IDs are 1-based, array indices are 0-based
+    // (Re)build the chunk grid when a different map is drawn or its size changed.
+    if (m_cachedTilemap != tilemapEntity
+        || m_chunkColumns != tilemap.getChunkColumns()
+        || m_chunkRows != tilemap.getChunkRows()) {
+        m_cachedTilemap = tilemapEntity;
+        m_chunkColumns = tilemap.getChunkColumns();
+        m_chunkRows = tilemap.getChunkRows();
+        m_chunks.clear();
+        m_chunks.resize(static_cast<size_t>(m_chunkColumns) * m_chunkRows);
+    }
 
-                // Calculate source rect from the tileset atlas
-                int srcX = (tileIndex % tileset->columns) * tileset->tileWidth;
-                int srcY = (tileIndex / tileset->columns) * tileset->tileHeight;
-                SDL_Rect srcRect = {srcX, srcY, tileset->tileWidth, tileset->tileHeight};
+    // Determine which chunks are visible
+    const int chunkPixelWidth = TilemapComponent::CHUNK_SIZE_IN_TILES * tilemap.tileWidth;
+    const int chunkPixelHeight = TilemapComponent::CHUNK_SIZE_IN_TILES * tilemap.tileHeight;
+    const int startChunkCol = std::max(0, static_cast<int>(std::floor(cameraLeft / chunkPixelWidth)));
+    const int startChunkRow = std::max(0, static_cast<int>(std::floor(cameraTop / chunkPixelHeight)));
+    const int endChunkCol = std::min(m_chunkColumns, static_cast<int>(std::floor((cameraLeft + screen.w - 1) / chunkPixelWidth) + 1));
+    const int endChunkRow = std::min(m_chunkRows, static_cast<int>(std::floor((cameraTop + screen.h - 1) / chunkPixelHeight) + 1));
 
-                // Calculate destination rect using integer coordinates for pixel-perfect drawing.
-                SDL_Rect destRect = {
-                    static_cast<int>(std::round((col * tilemap.tileWidth) - cameraLeft)),
-                    static_cast<int>(std::round((row * tilemap.tileHeight) - cameraTop)),
-                    tilemap.tileWidth,
-                    tilemap.tileHeight
-                };
-                SDL_RenderCopy(renderer, texture, &srcRect, &destRect);
+    // Draw each visible chunk with a single copy. Chunks are baked lazily the first time they
+    // become visible, and re-baked only when a tile inside them changed.
+    for (int chunkRow = startChunkRow; chunkRow < endChunkRow; ++chunkRow) {
+        for (int chunkCol = startChunkCol; chunkCol < endChunkCol; ++chunkCol) {
+            Chunk& chunk = m_chunks[chunkRow * m_chunkColumns + chunkCol];
+            if (!chunk.isBaked || chunk.bakedRevision != tilemap.getChunkRevision(chunkCol, chunkRow)) {
+                if (!bakeChunk(renderer, tilemap, *tileset, chunkCol, chunkRow, chunk)) {
+                    // Draw just this chunk tile by tile; the chunks already drawn this frame must not be drawn again.
+                    constexpr int chunkSize = TilemapComponent::CHUNK_SIZE_IN_TILES;
+                    drawTiles(renderer, tilemap, *tileset, chunkCol * chunkSize, chunkRow * chunkSize,
+                        std::min(tilemap.getWidthInTiles(), (chunkCol + 1) * chunkSize),
+                        std::min(tilemap.getHeightInTiles(), (chunkRow + 1) * chunkSize), cameraLeft, cameraTop);
+                    continue;
+                }
             }
+
+            int chunkTextureW, chunkTextureH;
+            SDL_QueryTexture(chunk.texture.get(), nullptr, nullptr, &chunkTextureW, &chunkTextureH);
+
+            // Calculate destination rect using integer coordinates for pixel-perfect drawing.
+            SDL_Rect destRect = {
+                static_cast<int>(std::round((chunkCol * chunkPixelWidth) - cameraLeft)),
+                static_cast<int>(std::round((chunkRow * chunkPixelHeight) - cameraTop)),
+                chunkTextureW,
+                chunkTextureH
+            };
+            SDL_RenderCopy(renderer, chunk.texture.get(), nullptr, &destRect);
         }
     }
 }
@@ -1,11 +1,65 @@
 #pragma once
 
 #include "../core/systems/isystem.hpp"
+#include "../util/sprite_asset.hpp" // For SDL_Texture_Deleter
+#include <memory>
+#include <vector>
+
+struct TilemapComponent;
+struct TilesetAsset;
 
 class TilemapRenderSystem: public IRenderSystem {
 public:
+    const char* getName() const override { return "TilemapRenderSystem"; }
     TilemapRenderSystem() = default;
 
+    void init(entt::registry& registry) override;
+    // Drops the chunk cache: after a reset the chunk textures are blank even though they are marked baked.
+    void onRenderTargetsReset() override { invalidateChunks(); }
     void draw(SDL_Renderer* renderer, entt::registry& registry,
         ResourceManager& resourceManager) override;
+
+private:
+    /**
+     * @struct Chunk
+     * @brief A block of CHUNK_SIZE_IN_TILES x CHUNK_SIZE_IN_TILES tiles, pre-rasterized
+     * (all layers) into a render-target texture so it can be drawn with a single copy.
+     */
+    struct Chunk {
+        std::unique_ptr<SDL_Texture, SDL_Texture_Deleter> texture;
+        uint32_t bakedRevision = 0;
+        bool isBaked = false;
+    };
+
+    // signal listener, drops the chunk cache when the tilemap is added, replaced, patched or removed.
+    void onTilemapChanged(entt::registry& registry, entt::entity entity);
+
+    // Drops every chunk; they are recreated and re-baked the next time they are visible.
+    void invalidateChunks();
+
+    /**
+     * @brief Rasterizes every layer of one chunk into its target texture.
+     * @return False if the texture could not be created or used as a render target.
+     */
+    bool bakeChunk(SDL_Renderer* renderer, const TilemapComponent& tilemap, const TilesetAsset& tileset,
+        int chunkCol, int chunkRow, Chunk& chunk);
+
+    /**
+     * @brief Fallback path: draws each visible tile individually, every frame.
+     * Used when the renderer does not support render targets.
+     */
+    void drawVisibleTiles(SDL_Renderer* renderer, const TilemapComponent& tilemap, const TilesetAsset& tileset,
+        float cameraLeft, float cameraTop, float viewWidth, float viewHeight);
+
+    /**
+     * @brief Draws every tile of every layer in columns [startCol, endCol) and rows [startRow, endRow) individually.
+     */
+    void drawTiles(SDL_Renderer* renderer, const TilemapComponent& tilemap, const TilesetAsset& tileset,
+        int startCol, int startRow, int endCol, int endRow, float cameraLeft, float cameraTop);
+
+    // Chunk cache for the tilemap entity currently being drawn, row-major.
+    entt::entity m_cachedTilemap{entt::null};
+    int m_chunkColumns = 0;
+    int m_chunkRows = 0;
+    std::vector<Chunk> m_chunks;
 };
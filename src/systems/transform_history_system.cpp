@@ -0,0 +1,20 @@
+#include "transform_history_system.hpp"
+#include "../components/transform.hpp"
+
+SystemAccess TransformHistorySystem::getAccess() const {
+    return SystemAccess{}.read<TransformComponent>().write<PreviousTransformComponent>();
+}
+
+void TransformHistorySystem::update(entt::registry& registry, InputManager&, ResourceManager&, float) {
+    // Entities that appeared since the last tick start with no history. Their previous
+    // position is their current one, so they don't "slide in" from the origin.
+    auto newEntities = registry.view<const TransformComponent>(entt::exclude<PreviousTransformComponent>);
+    for (const auto entity : newEntities) {
+        registry.emplace<PreviousTransformComponent>(entity, newEntities.get<const TransformComponent>(entity).position);
+    }
+
+    auto view = registry.view<const TransformComponent, PreviousTransformComponent>();
+    for (const auto entity : view) {
+        view.get<PreviousTransformComponent>(entity).position = view.get<const TransformComponent>(entity).position;
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../core/systems/isystem.hpp"
+
+/**
+ * @class TransformHistorySystem
+ * @brief Records every entity's position before the simulation advances, so render systems
+ * can interpolate between the previous and the current tick.
+ * Must be the first update system in the pipeline.
+ */
+class TransformHistorySystem : public IUpdateSystem {
+public:
+    const char* getName() const override { return "TransformHistorySystem"; }
+    SystemAccess getAccess() const override;
+    void update(entt::registry& registry, InputManager& inputManager, ResourceManager& resourceManager, float deltaTime) override;
+};
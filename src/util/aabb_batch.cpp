@@ -0,0 +1,173 @@
+#include "aabb_batch.hpp"
+
+// The SIMD kernels need GCC/Clang builtins; other compilers and CPUs use the scalar loop.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define AABB_BATCH_X86 1
+#include <immintrin.h>
+// The AVX2 kernel is compiled for that target on its own, so the rest of the build keeps
+// its baseline flags and the CPU is checked at runtime before the kernel is ever called.
+#define AABB_BATCH_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AABB_BATCH_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AABB_BATCH_INLINE inline __attribute__((always_inline))
+#else
+#define AABB_BATCH_INLINE inline
+#endif
+
+namespace AabbBatch {
+namespace {
+
+    using Kernel = uint32_t (*)(const AabbArrays&, uint32_t, uint32_t, const QuadtreeRect&, uint32_t*);
+
+    // The helpers below are force-inlined into every kernel, so the AVX2 kernel never calls out to
+    // code that isn't VEX encoded: switching between the two costs far more than the test itself.
+    AABB_BATCH_INLINE uint32_t appendOverlapsScalar(const AabbArrays& rects, uint32_t begin, uint32_t end,
+                                                    const QuadtreeRect& area, uint32_t* hits, uint32_t count) {
+        const int32_t areaMinX = area.x, areaMinY = area.y;
+        const int32_t areaMaxX = area.x + area.w, areaMaxY = area.y + area.h;
+        for (uint32_t i = begin; i < end; ++i) {
+            // Always store, only advance on a hit: no branch to mispredict.
+            hits[count] = i;
+            count += (areaMinX < rects.maxX[i]) & (areaMaxX > rects.minX[i]) &
+                     (areaMinY < rects.maxY[i]) & (areaMaxY > rects.minY[i]);
+        }
+        return count;
+    }
+
+    uint32_t findOverlapsScalar(const AabbArrays& rects, uint32_t begin, uint32_t end,
+                                const QuadtreeRect& area, uint32_t* hits) {
+        return appendOverlapsScalar(rects, begin, end, area, hits, 0);
+    }
+
+#if AABB_BATCH_X86
+    // Four rectangles starting at i.
+    AABB_BATCH_INLINE uint32_t appendOverlaps4(const AabbArrays& rects, uint32_t i, const QuadtreeRect& area,
+                                               uint32_t* hits, uint32_t count) {
+        const __m128i areaMinX = _mm_set1_epi32(area.x);
+        const __m128i areaMinY = _mm_set1_epi32(area.y);
+        const __m128i areaMaxX = _mm_set1_epi32(area.x + area.w);
+        const __m128i areaMaxY = _mm_set1_epi32(area.y + area.h);
+        const __m128i minX = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rects.minX.data() + i));
+        const __m128i minY = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rects.minY.data() + i));
+        const __m128i maxX = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rects.maxX.data() + i));
+        const __m128i maxY = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rects.maxY.data() + i));
+        const __m128i overlapX = _mm_and_si128(_mm_cmpgt_epi32(maxX, areaMinX), _mm_cmpgt_epi32(areaMaxX, minX));
+        const __m128i overlapY = _mm_and_si128(_mm_cmpgt_epi32(maxY, areaMinY), _mm_cmpgt_epi32(areaMaxY, minY));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(overlapX, overlapY))));
+        while (mask) {
+            hits[count++] = i + static_cast<uint32_t>(__builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+        return count;
+    }
+
+    uint32_t findOverlapsSSE2(const AabbArrays& rects, uint32_t begin, uint32_t end,
+                              const QuadtreeRect& area, uint32_t* hits) {
+        uint32_t count = 0;
+        uint32_t i = begin;
+        for (; i + 4 <= end; i += 4) {
+            count = appendOverlaps4(rects, i, area, hits, count);
+        }
+        return appendOverlapsScalar(rects, i, end, area, hits, count);
+    }
+
+    AABB_BATCH_TARGET_AVX2
+    uint32_t findOverlapsAVX2(const AabbArrays& rects, uint32_t begin, uint32_t end,
+                              const QuadtreeRect& area, uint32_t* hits) {
+        const __m256i areaMinX = _mm256_set1_epi32(area.x);
+        const __m256i areaMinY = _mm256_set1_epi32(area.y);
+        const __m256i areaMaxX = _mm256_set1_epi32(area.x + area.w);
+        const __m256i areaMaxY = _mm256_set1_epi32(area.y + area.h);
+
+        uint32_t count = 0;
+        uint32_t i = begin;
+        for (; i + 8 <= end; i += 8) {
+            const __m256i minX = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rects.minX.data() + i));
+            const __m256i minY = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rects.minY.data() + i));
+            const __m256i maxX = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rects.maxX.data() + i));
+            const __m256i maxY = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rects.maxY.data() + i));
+            const __m256i overlapX = _mm256_and_si256(_mm256_cmpgt_epi32(maxX, areaMinX), _mm256_cmpgt_epi32(areaMaxX, minX));
+            const __m256i overlapY = _mm256_and_si256(_mm256_cmpgt_epi32(maxY, areaMinY), _mm256_cmpgt_epi32(areaMaxY, minY));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(overlapX, overlapY))));
+            while (mask) {
+                hits[count++] = i + static_cast<uint32_t>(__builtin_ctz(mask));
+                mask &= mask - 1;
+            }
+        }
+        // The 1-7 left over: one 4-wide step, then one at a time.
+        if (i + 4 <= end) {
+            count = appendOverlaps4(rects, i, area, hits, count);
+            i += 4;
+        }
+        return appendOverlapsScalar(rects, i, end, area, hits, count);
+    }
+#endif
+
+    bool isSupported(InstructionSet instructionSet) {
+        switch (instructionSet) {
+            case InstructionSet::Scalar:
+                return true;
+            case InstructionSet::SSE2:
+                // Part of the x86-64 baseline.
+                return AABB_BATCH_X86;
+            case InstructionSet::AVX2:
+#if AABB_BATCH_X86
+                // May run during static initialization, before the runtime has probed the CPU itself.
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2");
+#else
+                return false;
+#endif
+        }
+        return false;
+    }
+
+    Kernel getKernel(InstructionSet instructionSet) {
+        switch (instructionSet) {
+#if AABB_BATCH_X86
+            case InstructionSet::AVX2: return findOverlapsAVX2;
+            case InstructionSet::SSE2: return findOverlapsSSE2;
+#endif
+            default: return findOverlapsScalar;
+        }
+    }
+
+    InstructionSet detectInstructionSet() {
+        if (isSupported(InstructionSet::AVX2)) return InstructionSet::AVX2;
+        if (isSupported(InstructionSet::SSE2)) return InstructionSet::SSE2;
+        return InstructionSet::Scalar;
+    }
+
+    // Picked once, when the program starts.
+    InstructionSet g_instructionSet = detectInstructionSet();
+    Kernel g_kernel = getKernel(g_instructionSet);
+}
+
+uint32_t findOverlaps(const AabbArrays& rects, uint32_t begin, uint32_t end, const QuadtreeRect& area, uint32_t* hits) {
+    return g_kernel(rects, begin, end, area, hits);
+}
+
+InstructionSet getInstructionSet() {
+    return g_instructionSet;
+}
+
+bool setInstructionSet(InstructionSet instructionSet) {
+    if (!isSupported(instructionSet)) return false;
+    g_instructionSet = instructionSet;
+    g_kernel = getKernel(instructionSet);
+    return true;
+}
+
+const char* getInstructionSetName(InstructionSet instructionSet) {
+    switch (instructionSet) {
+        case InstructionSet::Scalar: return "scalar";
+        case InstructionSet::SSE2: return "sse2";
+        case InstructionSet::AVX2: return "avx2";
+    }
+    return "?";
+}
+
+}
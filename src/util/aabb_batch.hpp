@@ -0,0 +1,103 @@
+#pragma once
+
+#include "quadtree.hpp" // For QuadtreeRect
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct AabbArrays
+ * @brief Rectangles stored as one array per edge (structure of arrays), so the AabbBatch
+ * kernels can load the same edge of several rectangles with a single instruction.
+ * Edges are kept as min/max rather than x/y/w/h so an overlap test is four compares and no adds.
+ */
+struct AabbArrays {
+    std::vector<int32_t> minX;
+    std::vector<int32_t> minY;
+    std::vector<int32_t> maxX;
+    std::vector<int32_t> maxY;
+
+    size_t size() const { return minX.size(); }
+
+    void clear() {
+        minX.clear();
+        minY.clear();
+        maxX.clear();
+        maxY.clear();
+    }
+
+    void resize(size_t count) {
+        minX.resize(count);
+        minY.resize(count);
+        maxX.resize(count);
+        maxY.resize(count);
+    }
+
+    void set(size_t index, const QuadtreeRect& rect) {
+        minX[index] = rect.x;
+        minY[index] = rect.y;
+        maxX[index] = rect.x + rect.w;
+        maxY[index] = rect.y + rect.h;
+    }
+
+    void push_back(const QuadtreeRect& rect) {
+        resize(size() + 1);
+        set(size() - 1, rect);
+    }
+};
+
+/**
+ * Batched AABB overlap tests: one query rectangle against many rectangles stored in an
+ * AabbArrays, 8 at a time with AVX2, 4 at a time with SSE2, or one at a time otherwise.
+ * The widest instruction set the CPU supports is picked on first use.
+ *
+ * Overlap is strict, like QuadtreeRect intersection everywhere else: rectangles that only
+ * share an edge don't overlap.
+ */
+namespace AabbBatch {
+
+    enum class InstructionSet {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    // Rectangles tested per findOverlaps() call by forEachOverlap(); bounds its stack buffer.
+    inline constexpr uint32_t CHUNK_SIZE = 64;
+
+    /**
+     * @brief Writes the index of every rectangle in [begin, end) that overlaps the area to hits, in order.
+     * @param hits Must have room for end - begin indices.
+     * @return The number of indices written.
+     */
+    uint32_t findOverlaps(const AabbArrays& rects, uint32_t begin, uint32_t end, const QuadtreeRect& area, uint32_t* hits);
+
+    /**
+     * @brief Calls visit(index) for every rectangle in [begin, end) that overlaps the area, in order.
+     * Needs no scratch memory outside the call, so it is safe to use from several threads at once.
+     */
+    template <typename Visit>
+    void forEachOverlap(const AabbArrays& rects, uint32_t begin, uint32_t end, const QuadtreeRect& area, Visit&& visit) {
+        uint32_t hits[CHUNK_SIZE];
+        for (uint32_t start = begin; start < end; start += CHUNK_SIZE) {
+            const uint32_t count = findOverlaps(rects, start, std::min(end, start + CHUNK_SIZE), area, hits);
+            for (uint32_t i = 0; i < count; ++i) {
+                visit(hits[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief The instruction set findOverlaps() currently uses.
+     */
+    InstructionSet getInstructionSet();
+
+    /**
+     * @brief Forces an instruction set, e.g. to compare them in a benchmark.
+     * Not thread safe with respect to running queries; call it before they start.
+     * @return False (and nothing changes) if this CPU or build doesn't support it.
+     */
+    bool setInstructionSet(InstructionSet instructionSet);
+
+    const char* getInstructionSetName(InstructionSet instructionSet);
+}
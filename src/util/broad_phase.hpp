@@ -0,0 +1,139 @@
+#pragma once
+
+#include "quadtree.hpp"
+#include "linear_quadtree.hpp"
+#include "spatial_hash.hpp"
+#include "sweep_and_prune.hpp"
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Index of an object in the caller's own dense array (e.g. the CollisionSystem's per-tick proxies).
+using BroadPhaseProxyId = uint32_t;
+// Two intersecting objects, lower id first.
+using BroadPhasePair = std::pair<BroadPhaseProxyId, BroadPhaseProxyId>;
+
+/**
+ * @enum BroadPhaseType
+ * @brief Selects the spatial structure the CollisionSystem uses to find potential contacts.
+ */
+enum class BroadPhaseType {
+    Quadtree,        // Pointer-based tree; allocates its nodes on every rebuild.
+    LinearQuadtree,  // Same tree in pooled flat arrays; no allocations after warm-up.
+    SpatialHash,     // Flat uniform grid; cheapest to rebuild when colliders are similar in size.
+    SweepAndPrune    // Sorted x endpoints kept across frames; best for many bodies that move a little per frame.
+};
+
+/**
+ * @class IBroadPhase
+ * @brief Interface for the collision broad phase.
+ *
+ * Every tick the CollisionSystem clears it, inserts all colliders and then queries it once
+ * per moving body. Objects are identified by proxy ids, so the caller can keep bounds and
+ * component pointers in a dense array instead of looking them up per candidate. query() must
+ * report each id whose bounds strictly intersect the area exactly once, in any order; it is
+ * non-const so implementations may build lazily.
+ *
+ * After build(), query() must not modify the broad phase until the next clear() or insert(),
+ * so several threads may query it at the same time.
+ */
+class IBroadPhase {
+public:
+    virtual ~IBroadPhase() = default;
+
+    virtual void clear() = 0;
+    virtual void insert(BroadPhaseProxyId id, const QuadtreeRect& bounds) = 0;
+    virtual void query(const QuadtreeRect& area, std::vector<BroadPhaseProxyId>& foundIds) = 0;
+
+    /**
+     * @brief Finishes any work deferred to the first query, so queries can then run concurrently.
+     */
+    virtual void build() {}
+
+    /**
+     * @brief Appends every intersecting pair of inserted objects once, lower id first, in any order.
+     * @return False if this broad phase has no direct pair search; callers then query per object.
+     */
+    virtual bool queryPairs(std::vector<BroadPhasePair>& pairs) { return false; }
+};
+
+class QuadtreeBroadPhase : public IBroadPhase {
+public:
+    explicit QuadtreeBroadPhase(const QuadtreeRect& worldBounds) : m_quadtree(0, worldBounds) {}
+
+    void clear() override { m_quadtree.clear(); }
+    void insert(BroadPhaseProxyId id, const QuadtreeRect& bounds) override { m_quadtree.insert(id, bounds); }
+    void query(const QuadtreeRect& area, std::vector<BroadPhaseProxyId>& foundIds) override {
+        m_quadtree.query(area, foundIds);
+    }
+
+private:
+    Quadtree<BroadPhaseProxyId> m_quadtree;
+};
+
+class LinearQuadtreeBroadPhase : public IBroadPhase {
+public:
+    explicit LinearQuadtreeBroadPhase(const QuadtreeRect& worldBounds) : m_quadtree(worldBounds) {}
+
+    void clear() override { m_quadtree.clear(); }
+    void insert(BroadPhaseProxyId id, const QuadtreeRect& bounds) override { m_quadtree.insert(id, bounds); }
+    void query(const QuadtreeRect& area, std::vector<BroadPhaseProxyId>& foundIds) override {
+        m_quadtree.query(area, foundIds);
+    }
+    void build() override { m_quadtree.build(); }
+
+private:
+    LinearQuadtree<BroadPhaseProxyId> m_quadtree;
+};
+
+class SpatialHashBroadPhase : public IBroadPhase {
+public:
+    explicit SpatialHashBroadPhase(float cellSize) : m_grid(cellSize) {}
+
+    void clear() override { m_grid.clear(); }
+    void insert(BroadPhaseProxyId id, const QuadtreeRect& bounds) override { m_grid.insert(id, bounds); }
+    void query(const QuadtreeRect& area, std::vector<BroadPhaseProxyId>& foundIds) override {
+        m_grid.query(area, foundIds);
+    }
+    void build() override { m_grid.build(); }
+
+private:
+    SpatialHash<BroadPhaseProxyId> m_grid;
+};
+
+class SweepAndPruneBroadPhase : public IBroadPhase {
+public:
+    void clear() override { m_sweepAndPrune.clear(); }
+    void insert(BroadPhaseProxyId id, const QuadtreeRect& bounds) override { m_sweepAndPrune.insert(id, bounds); }
+    void query(const QuadtreeRect& area, std::vector<BroadPhaseProxyId>& foundIds) override {
+        m_sweepAndPrune.query(area, foundIds);
+    }
+    void build() override { m_sweepAndPrune.build(); }
+    bool queryPairs(std::vector<BroadPhasePair>& pairs) override {
+        m_sweepAndPrune.queryPairs(pairs);
+        return true;
+    }
+
+private:
+    SweepAndPrune<BroadPhaseProxyId> m_sweepAndPrune;
+};
+
+/**
+ * @brief Creates the broad phase for the given type.
+ * @param worldBounds Area covered by tree-based broad phases.
+ * @param cellSize Cell side length for grid-based broad phases.
+ */
+inline std::unique_ptr<IBroadPhase> createBroadPhase(BroadPhaseType type, const QuadtreeRect& worldBounds, float cellSize) {
+    switch (type) {
+        case BroadPhaseType::SpatialHash:
+            return std::make_unique<SpatialHashBroadPhase>(cellSize);
+        case BroadPhaseType::SweepAndPrune:
+            return std::make_unique<SweepAndPruneBroadPhase>();
+        case BroadPhaseType::Quadtree:
+            return std::make_unique<QuadtreeBroadPhase>(worldBounds);
+        case BroadPhaseType::LinearQuadtree:
+        default:
+            return std::make_unique<LinearQuadtreeBroadPhase>(worldBounds);
+    }
+}
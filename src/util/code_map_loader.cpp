@@ -1,10 +1,15 @@
 #include "code_map_loader.hpp"
+#include "../core/trace.hpp"
 #include "../components/tilemap.hpp"
 #include "../components/transform.hpp"
 #include "../components/collider.hpp"
 #include "../components/rigidbody.hpp"
+#include "../components/tile_collision.hpp"
+#include "tile_collision_builder.hpp"
+#include "collision_geometry.hpp"
 #include "../util/resource_manager.hpp"
 #include <iostream>
+#include <unordered_set>
 
 // Helper to translate layer names to bitmasks.
 static uint32_t getLayerBitmask(const std::string& name) {
@@ -13,11 +18,12 @@ static uint32_t getLayerBitmask(const std::string& name) {
     return 0;
 }
 
-CodeMapLoader::CodeMapLoader(const TMX::Map& mapDescriptor)
-    : m_mapDescriptor(mapDescriptor) {}
+CodeMapLoader::CodeMapLoader(const TMX::Map& mapDescriptor, TilemapLoadOptions options)
+    : m_mapDescriptor(mapDescriptor), m_options(std::move(options)) {}
 
 bool CodeMapLoader::load(entt::registry& registry, entt::entity tilemapEntity,
                               ResourceManager& resourceManager, const std::string&) {
+    TRACE_ZONE("CodeMapLoader::load");
 
     // 1. Load Tileset Assets
     // This step ensures the textures for our tilesets are loaded into the ResourceManager.
@@ -57,7 +63,8 @@ bool CodeMapLoader::load(entt::registry& registry, entt::entity tilemapEntity,
             }
             else if constexpr (std::is_same_v<T, TMX::ObjectGroup>) {
                 // This is an object group. Check if it's our collision layer.
-                if (arg.name == "Collisions") {
+                // In TileGrid mode walls come from the tiles themselves, so the object layer is skipped.
+                if (arg.name == "Collisions" && m_options.collisionMode == TileCollisionMode::Objects) {
                     createCollisionObjects(registry, arg);
                 }
             }
@@ -70,38 +77,61 @@ bool CodeMapLoader::load(entt::registry& registry, entt::entity tilemapEntity,
         }, layerVariant);
     }
     
+    if (m_options.collisionMode == TileCollisionMode::TileGrid) {
+        // Collect the GIDs of every tile flagged solid in any tileset.
+        std::unordered_set<int> solidTileIds;
+        for (const auto& tilesetDesc : m_mapDescriptor.tilesets) {
+            for (const auto& tileDesc : tilesetDesc.tiles) {
+                if (!tileDesc.properties) continue;
+                for (const auto& prop : tileDesc.properties->list) {
+                    const bool* isSolid = std::get_if<bool>(&prop.value);
+                    if (prop.name == m_options.solidPropertyName && isSolid && *isSolid) {
+                        solidTileIds.insert(tilesetDesc.firstGid + tileDesc.id);
+                    }
+                }
+            }
+        }
+        registry.emplace_or_replace<TileCollisionGridComponent>(tilemapEntity,
+            buildTileCollisionGrid(tilemap, solidTileIds, m_options));
+    }
+
     std::cout << "CodeMapLoader: Successfully processed map descriptor." << std::endl;
     return true;
 }
 
 void CodeMapLoader::createCollisionObjects(entt::registry& registry, const TMX::ObjectGroup& objectGroup) {
+    std::vector<StaticCollisionRect> walls;
+    walls.reserve(objectGroup.objects.size());
     for (const auto& objectDesc : objectGroup.objects) {
-        const auto entity = registry.create();
-
-        // Position is the center of the AABB.
-        registry.emplace<TransformComponent>(entity,
-        Vec2f{objectDesc.position.x + objectDesc.size.x / 2.f, objectDesc.position.y + objectDesc.size.y / 2.f}
-        );
-
-        auto& collider = registry.emplace<ColliderComponent>(entity);
-        collider.size = {objectDesc.size.x, objectDesc.size.y};
-        collider.is_static = true;
+        StaticCollisionRect wall;
+        wall.position = {objectDesc.position.x, objectDesc.position.y};
+        wall.size = {objectDesc.size.x, objectDesc.size.y};
+        // Add a static rigidbody to all collision objects by default.
+        wall.hasStaticRigidbody = true;
 
         if (objectDesc.properties) {
             uint32_t mask = 0;
             for (const auto& prop : objectDesc.properties->list) {
                 if (prop.name == "collisionLayerName") {
-                    collider.layer = getLayerBitmask(std::get<std::string>(prop.value));
+                    wall.layer = getLayerBitmask(std::get<std::string>(prop.value));
                 } else if (prop.name == "collisionMaskNames") {
                     std::string maskStr = std::get<std::string>(prop.value);
                     // This could be extended to handle comma-separated values if needed.
                     mask |= getLayerBitmask(maskStr);
                 }
             }
-            collider.mask = mask;
+            wall.mask = mask;
         }
-        
-        // Add a static rigidbody to all collision objects by default.
-        registry.emplace<RigidBodyComponent>(entity, RigidBodyComponent{.bodyType = BodyType::STATIC, .mass = 0.0f});
+        walls.push_back(wall);
+    }
+
+    if (m_options.mergeCollisionRects) {
+        const size_t before = walls.size();
+        walls = mergeStaticCollisionRects(walls);
+        std::cout << "CodeMapLoader: Merged " << before << " collision rects into " << walls.size() << "." << std::endl;
+    }
+
+    for (const auto& wall : walls) {
+        createStaticColliderEntity(registry, wall);
     }
 }
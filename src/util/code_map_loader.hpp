@@ -8,7 +8,7 @@ class ResourceManager;
 
 class CodeMapLoader : public ITilemapLoader {
 public:
-    explicit CodeMapLoader(const TMX::Map& mapDescriptor);
+    explicit CodeMapLoader(const TMX::Map& mapDescriptor, TilemapLoadOptions options = {});
 
     bool load(entt::registry& registry,
               entt::entity tilemapEntity,
@@ -21,4 +21,5 @@ private:
     
     // A reference to the C++ map definition.
     const TMX::Map& m_mapDescriptor;
+    TilemapLoadOptions m_options;
 };
@@ -1,4 +1,5 @@
 #include "code_scene_loader.hpp"
+#include "../core/trace.hpp"
 #include "code_map_loader.hpp"
 #include "resource_manager.hpp"
 #include "../scenes/definitions/level1.hpp"
@@ -26,6 +27,7 @@
 
 bool CodeSceneLoader::load(entt::registry& registry, SDL_Renderer* renderer,
                                 ResourceManager* resourceManager, const std::string& sourcePath) {
+    TRACE_ZONE("CodeSceneLoader::load");
 
     // The sourcePath acts as a key to select which hardcoded scene to load.
     if (sourcePath != "Level1") {
@@ -34,8 +36,12 @@ bool CodeSceneLoader::load(entt::registry& registry, SDL_Renderer* renderer,
     }
 
     // --- Context Setup ---
-    int screenW, screenH;
-    SDL_GetRendererOutputSize(renderer, &screenW, &screenH);
+    int screenW = DEFAULT_SCREEN_WIDTH, screenH = DEFAULT_SCREEN_HEIGHT;
+    // Headless runs may have no renderer; keep the default logical size then.
+    if (renderer && SDL_GetRendererOutputSize(renderer, &screenW, &screenH) != 0) {
+        screenW = DEFAULT_SCREEN_WIDTH;
+        screenH = DEFAULT_SCREEN_HEIGHT;
+    }
     registry.ctx().emplace<ScreenDimensions>(static_cast<float>(screenW), static_cast<float>(screenH));
 
     // --- Asset Preloading (from Scene Descriptor) ---
@@ -83,21 +89,33 @@ bool CodeSceneLoader::load(entt::registry& registry, SDL_Renderer* renderer,
         if (!entityDesc.blackboard.empty() && registry.all_of<BlackboardComponent>(entity)) {
             auto& blackboard = registry.get<BlackboardComponent>(entity);
             for (const auto& [key, value] : entityDesc.blackboard) {
+                // Keys are hashed here, once; systems look them up by their BlackboardKeys constants.
+                const entt::id_type keyId = entt::hashed_string::value(key.c_str());
+                bool isStored = false;
                 // Check if the value is a string that matches an entity name
-                if (const auto* str_val = std::any_cast<const char*>(&value)) {
-                    if (nameToEntityMap.count(*str_val)) {
-                        blackboard.values[key] = nameToEntityMap.at(*str_val);
-                        continue;
-                    }
+                if (const auto* str_val = std::any_cast<const char*>(&value); str_val && nameToEntityMap.count(*str_val)) {
+                    isStored = blackboard.set(keyId, nameToEntityMap.at(*str_val));
+                } else if (const auto* bool_val = std::any_cast<bool>(&value)) {
+                    isStored = blackboard.set(keyId, *bool_val);
+                } else if (const auto* int_val = std::any_cast<int>(&value)) {
+                    isStored = blackboard.set(keyId, *int_val);
+                } else if (const auto* float_val = std::any_cast<float>(&value)) {
+                    isStored = blackboard.set(keyId, *float_val);
+                } else if (const auto* vec_val = std::any_cast<Vec2f>(&value)) {
+                    isStored = blackboard.set(keyId, *vec_val);
+                }
+                if (!isStored) {
+                    std::cerr << "CodeSceneLoader: Could not store blackboard key '" << key << "' on '" << entityDesc.name
+                              << "' (unsupported type, unknown entity or full blackboard)." << std::endl;
                 }
-                // Otherwise, assign the value as-is
-                blackboard.values[key] = value;
             }
         }
 
         // --- Post-processing: Set Sprite Dimensions from Asset ---
         if (auto* sprite = registry.try_get<SpriteComponent>(entity)) {
-            if (const auto* asset = resourceManager->getSpriteAsset(sprite->assetId)) {
+            // Resolve the asset handle once so systems never look it up by string.
+            sprite->assetHandle = resourceManager->getSpriteAssetHandle(sprite->assetId);
+            if (const auto* asset = resourceManager->getSpriteAsset(sprite->assetHandle)) {
                 sprite->width = asset->width;
                 sprite->height = asset->height;
             }
@@ -187,7 +205,7 @@ void CodeSceneLoader::createComponent(entt::registry& registry, entt::entity ent
         Transition transition;
         transition.toState = entt::hashed_string{transDesc.to.c_str()};
         for (const auto& condDesc : transDesc.conditions) {
-            transition.conditions.emplace_back(condDesc.blackboardKey, condDesc.expectedValue);
+            transition.conditions.emplace_back(entt::hashed_string::value(condDesc.blackboardKey.c_str()), condDesc.expectedValue);
         }
         fsm.transitions[entt::hashed_string{transDesc.from.c_str()}].push_back(transition);
     }
@@ -0,0 +1,121 @@
+#include "collision_geometry.hpp"
+#include "../components/transform.hpp"
+#include "../components/collider.hpp"
+#include "../components/rigidbody.hpp"
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <tuple>
+
+namespace {
+    // Above this many edge-grid cells a group is left unmerged (e.g. thousands of scattered, unaligned rects).
+    constexpr size_t MAX_MERGE_GRID_CELLS = 4 * 1024 * 1024;
+
+    std::vector<float> collectEdges(const std::vector<StaticCollisionRect>& rects, bool horizontal) {
+        std::vector<float> edges;
+        edges.reserve(rects.size() * 2);
+        for (const auto& rect : rects) {
+            const float start = horizontal ? rect.position.x : rect.position.y;
+            const float length = horizontal ? rect.size.x : rect.size.y;
+            edges.push_back(start);
+            edges.push_back(start + length);
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        return edges;
+    }
+
+    size_t edgeIndex(const std::vector<float>& edges, float value) {
+        return static_cast<size_t>(std::lower_bound(edges.begin(), edges.end(), value) - edges.begin());
+    }
+
+    void mergeGroup(const std::vector<StaticCollisionRect>& group, std::vector<StaticCollisionRect>& out) {
+        const std::vector<float> xs = collectEdges(group, true);
+        const std::vector<float> ys = collectEdges(group, false);
+        if (xs.size() < 2 || ys.size() < 2) return;
+
+        const size_t columns = xs.size() - 1;
+        const size_t rows = ys.size() - 1;
+        if (columns * rows > MAX_MERGE_GRID_CELLS) {
+            out.insert(out.end(), group.begin(), group.end());
+            return;
+        }
+
+        // 1. Rasterize every rect onto the edge grid.
+        std::vector<uint8_t> covered(columns * rows, 0);
+        for (const auto& rect : group) {
+            const size_t x0 = edgeIndex(xs, rect.position.x), x1 = edgeIndex(xs, rect.position.x + rect.size.x);
+            const size_t y0 = edgeIndex(ys, rect.position.y), y1 = edgeIndex(ys, rect.position.y + rect.size.y);
+            for (size_t row = y0; row < y1; ++row) {
+                std::fill(covered.begin() + row * columns + x0, covered.begin() + row * columns + x1, 1);
+            }
+        }
+
+        // 2. Greedy cover: take the first free cell, grow right, then grow down while the whole span is free.
+        const StaticCollisionRect& prototype = group.front();
+        for (size_t row = 0; row < rows; ++row) {
+            for (size_t col = 0; col < columns; ++col) {
+                if (!covered[row * columns + col]) continue;
+
+                size_t endCol = col + 1;
+                while (endCol < columns && covered[row * columns + endCol]) ++endCol;
+
+                size_t endRow = row + 1;
+                while (endRow < rows && std::all_of(covered.begin() + endRow * columns + col,
+                                                    covered.begin() + endRow * columns + endCol,
+                                                    [](uint8_t cell) { return cell != 0; })) {
+                    ++endRow;
+                }
+
+                for (size_t clearRow = row; clearRow < endRow; ++clearRow) {
+                    std::fill(covered.begin() + clearRow * columns + col, covered.begin() + clearRow * columns + endCol, 0);
+                }
+
+                StaticCollisionRect merged = prototype;
+                merged.position = {xs[col], ys[row]};
+                merged.size = {xs[endCol] - xs[col], ys[endRow] - ys[row]};
+                out.push_back(merged);
+            }
+        }
+    }
+}
+
+std::vector<StaticCollisionRect> mergeStaticCollisionRects(const std::vector<StaticCollisionRect>& rects) {
+    // Group by everything that makes two walls behave differently.
+    std::vector<StaticCollisionRect> merged;
+    std::map<std::tuple<uint32_t, uint32_t, bool>, std::vector<StaticCollisionRect>> groups;
+    for (const auto& rect : rects) {
+        // Degenerate rects cover no area on the grid; pass them through untouched.
+        if (rect.size.x <= 0.0f || rect.size.y <= 0.0f) {
+            merged.push_back(rect);
+            continue;
+        }
+        groups[{rect.layer, rect.mask, rect.hasStaticRigidbody}].push_back(rect);
+    }
+
+    for (const auto& [key, group] : groups) {
+        mergeGroup(group, merged);
+    }
+    return merged;
+}
+
+entt::entity createStaticColliderEntity(entt::registry& registry, const StaticCollisionRect& rect) {
+    const auto entity = registry.create();
+
+    // Position is the center of the AABB.
+    registry.emplace<TransformComponent>(entity,
+        Vec2f{rect.position.x + rect.size.x / 2.f, rect.position.y + rect.size.y / 2.f},
+        Vec2f{1.f, 1.f}
+    );
+
+    auto& collider = registry.emplace<ColliderComponent>(entity);
+    collider.size = rect.size;
+    collider.layer = rect.layer;
+    collider.mask = rect.mask;
+    collider.is_static = true;
+
+    if (rect.hasStaticRigidbody) {
+        registry.emplace<RigidBodyComponent>(entity, RigidBodyComponent{.bodyType = BodyType::STATIC, .mass = 0.0f});
+    }
+    return entity;
+}
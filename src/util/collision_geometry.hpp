@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../core/math_types.hpp"
+#include <cstdint>
+#include <vector>
+#include <entt/entt.hpp>
+
+/**
+ * @struct StaticCollisionRect
+ * @brief An axis-aligned wall rectangle read from a map, before it becomes an entity.
+ */
+struct StaticCollisionRect {
+    Vec2f position;  // Top-left corner, in world units.
+    Vec2f size;
+    uint32_t layer = 0;
+    uint32_t mask = 0;
+    bool hasStaticRigidbody = false; // Also give the entity a STATIC RigidBodyComponent.
+};
+
+/**
+ * @brief Greedily merges adjacent or overlapping rectangles into fewer, larger ones.
+ *
+ * Only rectangles with the same layer, mask and rigidbody flag are merged together. Each group
+ * is rasterized on a grid built from the rectangles' own edges, so off-grid positions are kept
+ * exactly, and that grid is re-covered with rows grown first horizontally, then vertically.
+ * The result covers exactly the same area; it is small, though not guaranteed minimal.
+ * Groups whose edge grid would be too large to rasterize are returned unmerged.
+ */
+std::vector<StaticCollisionRect> mergeStaticCollisionRects(const std::vector<StaticCollisionRect>& rects);
+
+/**
+ * @brief Creates a static collider entity (Transform + Collider, plus an optional STATIC rigidbody).
+ */
+entt::entity createStaticColliderEntity(entt::registry& registry, const StaticCollisionRect& rect);
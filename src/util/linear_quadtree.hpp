@@ -0,0 +1,258 @@
+#pragma once
+
+#include "quadtree.hpp" // For QuadtreeRect
+#include "aabb_batch.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class LinearQuadtree
+ * @brief A Quadtree with the same splitting rules and query results as Quadtree<T>, but
+ * stored in flat arrays.
+ *
+ * Nodes live in one vector (the four children of a node are contiguous) and objects live
+ * in another, chained per node through indices. Before the first query after a rebuild the
+ * chains are packed so each node's objects are contiguous, with their bounds in AabbArrays,
+ * so a query tests a node's objects several at a time with SIMD.
+ * clear() only resets sizes, so rebuilding the tree every frame does no heap allocations once
+ * the arrays have reached their peak size. Once packed, queries only read the tree and may run
+ * on several threads at once.
+ * @tparam T The type of object/identifier to store (e.g., entt::entity, uint32_t).
+ */
+template <typename T>
+class LinearQuadtree {
+public:
+    /**
+     * @brief Constructs a LinearQuadtree.
+     * @param bounds The rectangular boundary the root node represents.
+     */
+    explicit LinearQuadtree(QuadtreeRect bounds) : m_bounds(bounds) { clear(); }
+
+    /**
+     * @brief Removes all objects and nodes. Memory is kept for the next frame.
+     */
+    void clear();
+
+    /**
+     * @brief Inserts an object and its bounding box into the tree.
+     */
+    void insert(T object, QuadtreeRect objectBounds);
+
+    /**
+     * @brief Queries the tree and returns every object whose bounds intersect the given area.
+     * @param area The rectangular area to query against.
+     * @param foundObjects A reference to a vector that will be filled with potential colliders.
+     */
+    void query(QuadtreeRect area, std::vector<T>& foundObjects);
+
+    /**
+     * @brief Packs the tree now instead of on the next query.
+     */
+    void build() {
+        if (!m_isPacked) pack();
+    }
+
+    /**
+     * @brief Pre-sizes the arrays, e.g. to the expected object count, to skip the warm-up growth.
+     */
+    void reserve(size_t objectCount) {
+        m_objects.reserve(objectCount);
+        m_nodes.reserve(objectCount / MAX_OBJECTS * 4 + 1);
+    }
+
+private:
+    // Same limits as Quadtree<T> so both produce the same tree.
+    static constexpr int MAX_OBJECTS = 10;
+    static constexpr int MAX_LEVELS = 5;
+    static constexpr int32_t NONE = -1;
+    // Depth-first, each level leaves at most three siblings waiting, plus four children at the bottom.
+    static constexpr int MAX_QUERY_STACK = 4 * (MAX_LEVELS + 1);
+
+    struct Node {
+        QuadtreeRect bounds;
+        int level = 0;
+        int32_t firstChild = NONE;   // Index of the first of four contiguous children.
+        int32_t firstObject = NONE;  // Head of this node's object chain.
+        int objectCount = 0;
+        int32_t packedStart = 0;     // First of this node's objects in the packed arrays, valid once packed.
+    };
+
+    struct ObjectEntry {
+        T object;
+        QuadtreeRect bounds;
+        int32_t next = NONE;
+    };
+
+    QuadtreeRect m_bounds;
+    std::vector<Node> m_nodes;
+    std::vector<ObjectEntry> m_objects;
+    std::vector<T> m_packedObjects;
+    AabbArrays m_packedBounds;
+    bool m_isPacked = false;
+
+    void split(int32_t nodeIndex);
+    void pack();
+    void insertEntry(int32_t nodeIndex, int32_t entryIndex);
+
+    /**
+     * @brief Same rule as Quadtree<T>::getIndex.
+     * @return The child slot (0-3) the rect fits in completely, or -1 if it straddles a midpoint.
+     */
+    int getIndex(const QuadtreeRect& nodeBounds, const QuadtreeRect& rect) const {
+        int index = -1;
+        double verticalMidpoint = nodeBounds.x + (nodeBounds.w / 2.0);
+        double horizontalMidpoint = nodeBounds.y + (nodeBounds.h / 2.0);
+
+        bool topQuadrant = (rect.y < horizontalMidpoint && rect.y + rect.h < horizontalMidpoint);
+        bool bottomQuadrant = (rect.y > horizontalMidpoint);
+
+        if (rect.x < verticalMidpoint && rect.x + rect.w < verticalMidpoint) {
+            if (topQuadrant) index = 1;
+            else if (bottomQuadrant) index = 2;
+        }
+        else if (rect.x > verticalMidpoint) {
+            if (topQuadrant) index = 0;
+            else if (bottomQuadrant) index = 3;
+        }
+        return index;
+    }
+
+    bool hasIntersection(const QuadtreeRect& a, const QuadtreeRect& b) const {
+        return (a.x < b.x + b.w && a.x + a.w > b.x &&
+                a.y < b.y + b.h && a.y + a.h > b.y);
+    }
+};
+
+template <typename T>
+void LinearQuadtree<T>::clear() {
+    m_objects.clear();
+    m_nodes.clear();
+    m_isPacked = false;
+    Node root;
+    root.bounds = m_bounds;
+    m_nodes.push_back(root);
+}
+
+template <typename T>
+void LinearQuadtree<T>::split(int32_t nodeIndex) {
+    // Copy what we need: push_back below may reallocate m_nodes.
+    const QuadtreeRect bounds = m_nodes[nodeIndex].bounds;
+    const int childLevel = m_nodes[nodeIndex].level + 1;
+    int subWidth = bounds.w / 2;
+    int subHeight = bounds.h / 2;
+    int x = bounds.x;
+    int y = bounds.y;
+
+    const QuadtreeRect childBounds[4] = {
+        {x + subWidth, y, subWidth, subHeight},
+        {x, y, subWidth, subHeight},
+        {x, y + subHeight, subWidth, subHeight},
+        {x + subWidth, y + subHeight, subWidth, subHeight}
+    };
+
+    const auto firstChild = static_cast<int32_t>(m_nodes.size());
+    for (const auto& rect : childBounds) {
+        Node child;
+        child.bounds = rect;
+        child.level = childLevel;
+        m_nodes.push_back(child);
+    }
+    m_nodes[nodeIndex].firstChild = firstChild;
+}
+
+template <typename T>
+void LinearQuadtree<T>::insert(T object, QuadtreeRect objectBounds) {
+    const auto entryIndex = static_cast<int32_t>(m_objects.size());
+    m_objects.push_back({object, objectBounds, NONE});
+    insertEntry(0, entryIndex);
+    m_isPacked = false;
+}
+
+template <typename T>
+void LinearQuadtree<T>::pack() {
+    m_packedObjects.resize(m_objects.size());
+    m_packedBounds.resize(m_objects.size());
+    int32_t cursor = 0;
+    for (auto& node : m_nodes) {
+        node.packedStart = cursor;
+        for (int32_t entry = node.firstObject; entry != NONE; entry = m_objects[entry].next) {
+            m_packedObjects[cursor] = m_objects[entry].object;
+            m_packedBounds.set(cursor, m_objects[entry].bounds);
+            ++cursor;
+        }
+    }
+    m_isPacked = true;
+}
+
+template <typename T>
+void LinearQuadtree<T>::insertEntry(int32_t nodeIndex, int32_t entryIndex) {
+    // Descend as far as the object fits completely inside a child.
+    while (m_nodes[nodeIndex].firstChild != NONE) {
+        int index = getIndex(m_nodes[nodeIndex].bounds, m_objects[entryIndex].bounds);
+        if (index == -1) break;
+        nodeIndex = m_nodes[nodeIndex].firstChild + index;
+    }
+
+    m_objects[entryIndex].next = m_nodes[nodeIndex].firstObject;
+    m_nodes[nodeIndex].firstObject = entryIndex;
+    ++m_nodes[nodeIndex].objectCount;
+
+    if (m_nodes[nodeIndex].objectCount <= MAX_OBJECTS || m_nodes[nodeIndex].level >= MAX_LEVELS) {
+        return;
+    }
+
+    if (m_nodes[nodeIndex].firstChild == NONE) {
+        split(nodeIndex);
+    }
+
+    // Push down every object that now fits in a child by relinking it; nothing is copied or shifted.
+    // Links are tracked by index because splitting a child may reallocate m_nodes.
+    int32_t previous = NONE;
+    int32_t current = m_nodes[nodeIndex].firstObject;
+    while (current != NONE) {
+        const int32_t next = m_objects[current].next;
+        int index = getIndex(m_nodes[nodeIndex].bounds, m_objects[current].bounds);
+        if (index == -1) {
+            previous = current;
+            current = next;
+            continue;
+        }
+        if (previous == NONE) m_nodes[nodeIndex].firstObject = next;
+        else m_objects[previous].next = next;
+        --m_nodes[nodeIndex].objectCount;
+        insertEntry(m_nodes[nodeIndex].firstChild + index, current);
+        current = next;
+    }
+}
+
+template <typename T>
+void LinearQuadtree<T>::query(QuadtreeRect area, std::vector<T>& foundObjects) {
+    build();
+
+    // Check if the query area intersects with the root's bounds before proceeding
+    if (!hasIntersection(area, m_nodes[0].bounds)) {
+        return;
+    }
+
+    // Only nodes that intersect the area are ever pushed. The stack lives on the call's own
+    // frame so concurrent queries don't share anything.
+    int32_t stack[MAX_QUERY_STACK];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+
+        const auto begin = static_cast<uint32_t>(node.packedStart);
+        AabbBatch::forEachOverlap(m_packedBounds, begin, begin + node.objectCount, area,
+            [&](uint32_t index) { foundObjects.push_back(m_packedObjects[index]); });
+
+        if (node.firstChild != NONE) {
+            for (int32_t child = node.firstChild; child < node.firstChild + 4; ++child) {
+                if (hasIntersection(area, m_nodes[child].bounds)) {
+                    stack[stackSize++] = child;
+                }
+            }
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include "resource_manager.hpp"
+#include "../core/trace.hpp"
 #include "tileset_asset_loader.hpp"
 #include <iostream>
 
@@ -22,15 +23,20 @@ ResourceManager::ResourceManager() {
 ResourceManager::~ResourceManager() = default; // Smart pointers handle cleanup
 
 const SpriteAsset* ResourceManager::getSpriteAsset(const std::string& assetId) const {
-    auto it = m_spriteAssetCache.find(assetId);
-    if (it != m_spriteAssetCache.end()) {
-        return it->second.get();
+    // Returns nullptr if the asset was not pre-loaded.
+    return getSpriteAsset(getSpriteAssetHandle(assetId));
+}
+
+SpriteAssetHandle ResourceManager::getSpriteAssetHandle(const std::string& assetId) const {
+    auto it = m_spriteAssetHandles.find(assetId);
+    if (it != m_spriteAssetHandles.end()) {
+        return it->second;
     }
-    // Return nullptr if the asset was not pre-loaded.
-    return nullptr;
+    return INVALID_SPRITE_ASSET_HANDLE;
 }
 
 const SpriteAsset* ResourceManager::loadSpriteAsset(SDL_Renderer* renderer, const std::string& assetId) {
+    TRACE_ZONE("ResourceManager::loadSpriteAsset");
     // First, check the cache.
     if (auto* asset = getSpriteAsset(assetId)) {
         return asset;
@@ -46,14 +52,17 @@ const SpriteAsset* ResourceManager::loadSpriteAsset(SDL_Renderer* renderer, cons
             std::cerr << "Asset ID Mismatch! ..." << std::endl;
             return nullptr;
         }
-        auto [inserted_it, success] = m_spriteAssetCache.emplace(assetId, std::move(asset));
-        return inserted_it->second.get();
+        const auto handle = static_cast<SpriteAssetHandle>(m_spriteAssets.size());
+        m_spriteAssets.push_back(std::move(asset));
+        m_spriteAssetHandles.emplace(assetId, handle);
+        return m_spriteAssets.back().get();
     }
     return nullptr;
 }
 
 const TilesetAsset* ResourceManager::loadTilesetAsset(SDL_Renderer* renderer,
     const std::string& assetId, const std::string& sourceHint) {
+    TRACE_ZONE("ResourceManager::loadTilesetAsset");
     if (auto* asset = getTilesetAsset(assetId)) {
         return asset;
     }
@@ -33,6 +33,19 @@ public:
      */
     const SpriteAsset* getSpriteAsset(const std::string& assetId) const;
 
+    /**
+     * @brief Returns the stable handle of a pre-loaded asset, or INVALID_SPRITE_ASSET_HANDLE.
+     * Meant to be called at load time; store the result next to the assetId.
+     */
+    SpriteAssetHandle getSpriteAssetHandle(const std::string& assetId) const;
+
+    /**
+     * @brief Gets a pre-loaded asset by handle. This is a plain array index, no hashing involved.
+     */
+    const SpriteAsset* getSpriteAsset(SpriteAssetHandle handle) const {
+        return handle < m_spriteAssets.size() ? m_spriteAssets[handle].get() : nullptr;
+    }
+
     const TilesetAsset* loadTilesetAsset(SDL_Renderer* renderer, const std::string& assetId, const std::string& sourceHint = "");
     const TilesetAsset* getTilesetAsset(const std::string& assetId) const;
 
@@ -40,6 +53,9 @@ public:
 
 private:
     std::string m_basePath;
-    std::unordered_map<std::string, std::unique_ptr<SpriteAsset>> m_spriteAssetCache;
+    // Dense table of sprite assets; a SpriteAssetHandle is an index into it.
+    std::vector<std::unique_ptr<SpriteAsset>> m_spriteAssets;
+    // Maps an assetId to its handle. Only used at load time.
+    std::unordered_map<std::string, SpriteAssetHandle> m_spriteAssetHandles;
     std::unordered_map<std::string, std::unique_ptr<TilesetAsset>> m_tilesetAssetCache;
 };
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "quadtree.hpp" // For QuadtreeRect
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SpatialHash
+ * @brief A uniform grid whose cells are hashed into a flat bucket table.
+ *
+ * Objects are inserted into every cell their bounds overlap. The bucket table is built
+ * lazily on the first query after an insert with a counting sort (count, prefix sum, fill),
+ * so a full per-frame rebuild only touches a few flat arrays that keep their capacity.
+ * Works best when most objects are about one cell in size.
+ * Queries keep no state, so once built they may run on several threads at once.
+ * @tparam T The type of object/identifier to store (e.g., entt::entity, uint32_t).
+ */
+template <typename T>
+class SpatialHash {
+public:
+    /**
+     * @brief Constructs a SpatialHash.
+     * @param cellSize The side length of a grid cell, in world units.
+     */
+    explicit SpatialHash(float cellSize) { setCellSize(cellSize); }
+
+    /**
+     * @brief Changes the cell size. Takes effect on the next build.
+     */
+    void setCellSize(float cellSize) {
+        m_cellSize = (cellSize > 0.0f) ? cellSize : 64.0f;
+        m_inverseCellSize = 1.0f / m_cellSize;
+        m_isBuilt = false;
+    }
+
+    float getCellSize() const { return m_cellSize; }
+
+    /**
+     * @brief Removes all objects. Memory is kept for the next frame.
+     */
+    void clear();
+
+    /**
+     * @brief Adds an object and its bounding box.
+     */
+    void insert(T object, QuadtreeRect objectBounds);
+
+    /**
+     * @brief Builds the bucket table now instead of on the next query.
+     */
+    void build() {
+        if (!m_isBuilt) rebuildBuckets();
+    }
+
+    /**
+     * @brief Finds every object whose bounds intersect the given area. Each object is reported once.
+     * @param area The rectangular area to query against.
+     * @param foundObjects A reference to a vector that will be filled with the matching objects.
+     */
+    void query(QuadtreeRect area, std::vector<T>& foundObjects);
+
+private:
+    // Objects spanning more cells than this are kept in a separate list tested on every query,
+    // so a single huge collider cannot flood the bucket table.
+    static constexpr int MAX_CELLS_PER_OBJECT = 64;
+    static constexpr uint32_t MIN_BUCKET_COUNT = 64;
+
+    struct Entry {
+        T object;
+        QuadtreeRect bounds;
+    };
+
+    struct CellRange {
+        int minX, minY, maxX, maxY;
+    };
+
+    float m_cellSize = 64.0f;
+    float m_inverseCellSize = 1.0f / 64.0f;
+    bool m_isBuilt = false;
+
+    std::vector<Entry> m_entries;
+    std::vector<CellRange> m_entryCells;   // Per entry: the cells its bounds cover.
+    std::vector<uint32_t> m_oversized;     // Indices into m_entries.
+    std::vector<uint32_t> m_bucketStarts;  // bucketCount + 1 offsets into m_cellEntries.
+    std::vector<uint32_t> m_bucketCursor;  // Scratch for the fill pass.
+    std::vector<uint32_t> m_bucketStamps;  // Scratch: the last entry (+1) counted in each bucket.
+    std::vector<uint32_t> m_cellEntries;   // Indices into m_entries, grouped by bucket, at most once per bucket.
+    uint32_t m_bucketMask = 0;
+
+    void rebuildBuckets();
+
+    // Calls visit(bucket) once for every distinct bucket the entry's cells hash to.
+    template <typename Visit>
+    void forEachEntryBucket(uint32_t entryIndex, Visit&& visit) {
+        const CellRange& range = m_entryCells[entryIndex];
+        for (int cellY = range.minY; cellY <= range.maxY; ++cellY) {
+            for (int cellX = range.minX; cellX <= range.maxX; ++cellX) {
+                const uint32_t bucket = hashCell(cellX, cellY);
+                if (m_bucketStamps[bucket] == entryIndex + 1) continue;
+                m_bucketStamps[bucket] = entryIndex + 1;
+                visit(bucket);
+            }
+        }
+    }
+
+    CellRange getCellRange(const QuadtreeRect& rect) const {
+        return {
+            static_cast<int>(std::floor(rect.x * m_inverseCellSize)),
+            static_cast<int>(std::floor(rect.y * m_inverseCellSize)),
+            static_cast<int>(std::floor((rect.x + rect.w) * m_inverseCellSize)),
+            static_cast<int>(std::floor((rect.y + rect.h) * m_inverseCellSize))
+        };
+    }
+
+    static bool isOversized(const CellRange& range) {
+        const long long cells = static_cast<long long>(range.maxX - range.minX + 1) * (range.maxY - range.minY + 1);
+        return cells > MAX_CELLS_PER_OBJECT;
+    }
+
+    uint32_t hashCell(int cellX, int cellY) const {
+        return ((static_cast<uint32_t>(cellX) * 73856093u) ^ (static_cast<uint32_t>(cellY) * 19349663u)) & m_bucketMask;
+    }
+
+    bool hasIntersection(const QuadtreeRect& a, const QuadtreeRect& b) const {
+        return (a.x < b.x + b.w && a.x + a.w > b.x &&
+                a.y < b.y + b.h && a.y + a.h > b.y);
+    }
+
+};
+
+template <typename T>
+void SpatialHash<T>::clear() {
+    m_entries.clear();
+    m_isBuilt = false;
+}
+
+template <typename T>
+void SpatialHash<T>::insert(T object, QuadtreeRect objectBounds) {
+    m_entries.push_back({object, objectBounds});
+    m_isBuilt = false;
+}
+
+template <typename T>
+void SpatialHash<T>::rebuildBuckets() {
+    // Size the table to roughly twice the object count so buckets stay short.
+    uint32_t bucketCount = MIN_BUCKET_COUNT;
+    while (bucketCount < m_entries.size() * 2) bucketCount <<= 1;
+    m_bucketMask = bucketCount - 1;
+
+    m_oversized.clear();
+    m_bucketStarts.assign(bucketCount + 1, 0);
+    m_entryCells.resize(m_entries.size());
+    for (uint32_t i = 0; i < m_entries.size(); ++i) {
+        m_entryCells[i] = getCellRange(m_entries[i].bounds);
+    }
+
+    // Pass 1: count how many entries land in each bucket. An entry whose cells collide in the
+    // hash is listed once per bucket, which lets queries dedupe without any per-query state.
+    m_bucketStamps.assign(bucketCount, 0);
+    for (uint32_t i = 0; i < m_entries.size(); ++i) {
+        if (isOversized(m_entryCells[i])) {
+            m_oversized.push_back(i);
+            continue;
+        }
+        forEachEntryBucket(i, [this](uint32_t bucket) { ++m_bucketStarts[bucket + 1]; });
+    }
+
+    // Prefix sum turns the counts into start offsets.
+    for (uint32_t bucket = 1; bucket <= bucketCount; ++bucket) {
+        m_bucketStarts[bucket] += m_bucketStarts[bucket - 1];
+    }
+
+    // Pass 2: scatter entry indices into their buckets.
+    m_cellEntries.resize(m_bucketStarts[bucketCount]);
+    m_bucketCursor.assign(m_bucketStarts.begin(), m_bucketStarts.end() - 1);
+    m_bucketStamps.assign(bucketCount, 0);
+    for (uint32_t i = 0; i < m_entries.size(); ++i) {
+        if (isOversized(m_entryCells[i])) continue;
+        forEachEntryBucket(i, [this, i](uint32_t bucket) { m_cellEntries[m_bucketCursor[bucket]++] = i; });
+    }
+
+    m_isBuilt = true;
+}
+
+template <typename T>
+void SpatialHash<T>::query(QuadtreeRect area, std::vector<T>& foundObjects) {
+    build();
+    if (m_entries.empty()) return;
+
+    const CellRange range = getCellRange(area);
+    // An area covering more cells than there are buckets is cheaper to answer with a plain scan.
+    const long long areaCells = static_cast<long long>(range.maxX - range.minX + 1) * (range.maxY - range.minY + 1);
+    if (areaCells > static_cast<long long>(m_bucketMask) + 1) {
+        for (const auto& entry : m_entries) {
+            if (hasIntersection(area, entry.bounds)) foundObjects.push_back(entry.object);
+        }
+        return;
+    }
+
+    for (const uint32_t entryIndex : m_oversized) {
+        if (hasIntersection(area, m_entries[entryIndex].bounds)) {
+            foundObjects.push_back(m_entries[entryIndex].object);
+        }
+    }
+
+    for (int cellY = range.minY; cellY <= range.maxY; ++cellY) {
+        for (int cellX = range.minX; cellX <= range.maxX; ++cellX) {
+            const uint32_t bucket = hashCell(cellX, cellY);
+            for (uint32_t i = m_bucketStarts[bucket]; i < m_bucketStarts[bucket + 1]; ++i) {
+                const uint32_t entryIndex = m_cellEntries[i];
+                // An object sharing several cells with the area is reported only from the first of
+                // them (its reference cell). This also skips objects that only share the bucket
+                // through a hash collision, since those don't cover the current cell at all.
+                const CellRange& cells = m_entryCells[entryIndex];
+                if (cellX != std::max(range.minX, cells.minX) || cellY != std::max(range.minY, cells.minY)) continue;
+                if (cellX > cells.maxX || cellY > cells.maxY) continue;
+                if (hasIntersection(area, m_entries[entryIndex].bounds)) {
+                    foundObjects.push_back(m_entries[entryIndex].object);
+                }
+            }
+        }
+    }
+}
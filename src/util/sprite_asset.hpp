@@ -4,6 +4,8 @@
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
+#include <limits>
 #include <SDL2/SDL.h>
 #include "../core/entt_helpers.hpp"
 
@@ -21,6 +23,11 @@ struct AnimationFrame {
     int durationMs = 100;      // How long this frame should be displayed, in milliseconds.
 };
 
+// A stable handle to a loaded SpriteAsset: an index into the ResourceManager's dense asset table.
+// Resolve it once at load time, then use it in the game loop instead of the string assetId.
+using SpriteAssetHandle = uint32_t;
+inline constexpr SpriteAssetHandle INVALID_SPRITE_ASSET_HANDLE = std::numeric_limits<SpriteAssetHandle>::max();
+
 // An AnimationSequence is a vector of frames that defines a complete animation for one state.
 using AnimationSequence = std::vector<AnimationFrame>;
 
@@ -35,6 +42,10 @@ struct SpriteAsset {
     int width = 0;
     int height = 0;
 
+    // Size of the texture atlas in pixels, used to normalize texture coordinates.
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+
     // A single texture containing all frames laid out horizontally.
     std::unique_ptr<SDL_Texture, SDL_Texture_Deleter> textureAtlas;
 
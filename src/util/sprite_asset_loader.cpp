@@ -80,6 +80,15 @@ std::unique_ptr<SpriteAsset> SpriteAssetLoader::loadFromFile(SDL_Renderer* rende
     // --- Texture Atlas creation logic remains the same ---
     const int atlasWidth = asset->width * atlasFrames.size();
     const int atlasHeight = asset->height;
+    asset->atlasWidth = atlasWidth;
+    asset->atlasHeight = atlasHeight;
+
+    // Without a renderer (headless) there is nothing to upload to; dimensions and
+    // animations are still needed by the simulation.
+    if (!renderer) {
+        return asset;
+    }
+
     SDL_Texture* rawTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, atlasWidth, atlasHeight);
     if (!rawTexture) {
         std::cerr << "Failed to create texture atlas: " << SDL_GetError() << std::endl;
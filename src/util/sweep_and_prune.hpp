@@ -0,0 +1,137 @@
+#pragma once
+
+#include "quadtree.hpp" // For QuadtreeRect
+#include "aabb_batch.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SweepAndPrune
+ * @brief Sort-and-sweep over the x axis, with the sort order kept between frames.
+ *
+ * Objects are identified by small dense ids (0..N-1) that should stay the same from frame to
+ * frame. clear() keeps the previous order, and the next build fixes it up with an insertion
+ * sort, which is close to linear when objects only move a little per frame. Overlapping pairs
+ * are then found with a single sweep, without building any tree. The bounds are also copied
+ * into AabbArrays in sorted order, so each sweep step tests its run of x-overlapping objects
+ * several at a time with SIMD. Once sorted, queries only read and may run on several threads at once.
+ * @tparam T An unsigned integer id type.
+ */
+template <typename T>
+class SweepAndPrune {
+public:
+    /**
+     * @brief Forgets the current bounds but keeps the sort order for the next frame.
+     */
+    void clear() {
+        std::fill(m_isPresent.begin(), m_isPresent.begin() + m_count, 0);
+        m_count = 0;
+        m_isSorted = false;
+    }
+
+    /**
+     * @brief Sets the bounds of an object for this frame.
+     */
+    void insert(T id, QuadtreeRect bounds) {
+        const size_t index = static_cast<size_t>(id);
+        if (index >= m_bounds.size()) {
+            m_bounds.resize(index + 1);
+            m_isPresent.resize(index + 1, 0);
+        }
+        m_bounds[index] = bounds;
+        m_isPresent[index] = 1;
+        m_count = std::max(m_count, index + 1);
+        m_isSorted = false;
+    }
+
+    /**
+     * @brief Sorts now instead of on the next query.
+     */
+    void build() { sort(); }
+
+    /**
+     * @brief Finds every object whose bounds intersect the given area.
+     * Scans every object starting left of the area's right edge; prefer queryPairs() when all pairs are needed.
+     * @param area The rectangular area to query against.
+     * @param foundObjects A reference to a vector that will be filled with the matching objects.
+     */
+    void query(QuadtreeRect area, std::vector<T>& foundObjects) {
+        sort();
+        // Everything starting at or after the area's right edge cannot overlap it.
+        const auto end = std::lower_bound(m_sortedBounds.minX.begin(), m_sortedBounds.minX.end(), area.x + area.w);
+        AabbBatch::forEachOverlap(m_sortedBounds, 0, static_cast<uint32_t>(end - m_sortedBounds.minX.begin()), area,
+            [&](uint32_t index) { foundObjects.push_back(m_order[index]); });
+    }
+
+    /**
+     * @brief Appends every intersecting pair once, as (lower id, higher id).
+     */
+    void queryPairs(std::vector<std::pair<T, T>>& pairs) {
+        sort();
+        const auto count = static_cast<uint32_t>(m_order.size());
+        const std::vector<int32_t>& minX = m_sortedBounds.minX;
+        for (uint32_t i = 0; i < count; ++i) {
+            const QuadtreeRect& a = m_bounds[m_order[i]];
+            // Sorted by x: the run of candidates ends at the first object starting past a's right edge.
+            uint32_t end = i + 1;
+            while (end < count && minX[end] < a.x + a.w) ++end;
+            AabbBatch::forEachOverlap(m_sortedBounds, i + 1, end, a, [&](uint32_t j) {
+                const T first = m_order[i], second = m_order[j];
+                pairs.emplace_back(std::min(first, second), std::max(first, second));
+            });
+        }
+    }
+
+private:
+    std::vector<QuadtreeRect> m_bounds; // Indexed by id.
+    std::vector<uint8_t> m_isPresent;   // Indexed by id: inserted this frame (2 = seen while sorting).
+    std::vector<T> m_order;             // Ids sorted by min x, carried over between frames.
+    AabbArrays m_sortedBounds;          // Bounds in m_order's order, rebuilt with it.
+    size_t m_count = 0;
+    bool m_isSorted = false;
+
+    void sort() {
+        if (m_isSorted) return;
+
+        // Drop ids that were not inserted this frame and append new ones at the end.
+        size_t keep = 0;
+        for (size_t i = 0; i < m_order.size(); ++i) {
+            const size_t index = static_cast<size_t>(m_order[i]);
+            if (index < m_count && m_isPresent[index] == 1) {
+                m_isPresent[index] = 2; // Already in the order.
+                m_order[keep++] = m_order[i];
+            }
+        }
+        m_order.resize(keep);
+        const size_t carriedOver = keep;
+        for (size_t index = 0; index < m_count; ++index) {
+            if (m_isPresent[index] == 1) m_order.push_back(static_cast<T>(index));
+            else if (m_isPresent[index] == 2) m_isPresent[index] = 1;
+        }
+
+        const auto lessX = [this](T a, T b) { return m_bounds[a].x < m_bounds[b].x; };
+        if (carriedOver * 4 < m_order.size() * 3) {
+            // Mostly new objects: no coherence to exploit.
+            std::sort(m_order.begin(), m_order.end(), lessX);
+        } else {
+            // Insertion sort: near linear when the order barely changed since last frame.
+            for (size_t i = 1; i < m_order.size(); ++i) {
+                const T id = m_order[i];
+                size_t j = i;
+                while (j > 0 && lessX(id, m_order[j - 1])) {
+                    m_order[j] = m_order[j - 1];
+                    --j;
+                }
+                m_order[j] = id;
+            }
+        }
+
+        m_sortedBounds.resize(m_order.size());
+        for (size_t i = 0; i < m_order.size(); ++i) {
+            m_sortedBounds.set(i, m_bounds[m_order[i]]);
+        }
+        m_isSorted = true;
+    }
+};
@@ -0,0 +1,32 @@
+#include "tile_collision_builder.hpp"
+#include <algorithm>
+
+TileCollisionGridComponent buildTileCollisionGrid(const TilemapComponent& tilemap,
+    const std::unordered_set<int>& solidTileIds, const TilemapLoadOptions& options) {
+    TileCollisionGridComponent grid;
+    grid.tileWidth = tilemap.tileWidth;
+    grid.tileHeight = tilemap.tileHeight;
+    grid.layer = options.solidLayer;
+    grid.mask = options.solidMask;
+
+    // Layers may disagree on size; cover the largest one.
+    int width = 0, height = 0;
+    for (const auto& layer : tilemap.layers) {
+        width = std::max(width, layer.widthInTiles);
+        height = std::max(height, layer.heightInTiles);
+    }
+    grid.resize(width, height);
+    if (solidTileIds.empty()) return grid;
+
+    for (const auto& layer : tilemap.layers) {
+        for (int row = 0; row < layer.heightInTiles; ++row) {
+            for (int col = 0; col < layer.widthInTiles; ++col) {
+                const size_t index = static_cast<size_t>(row) * layer.widthInTiles + col;
+                if (index < layer.tileIds.size() && solidTileIds.count(layer.tileIds[index])) {
+                    grid.setSolid(col, row, true);
+                }
+            }
+        }
+    }
+    return grid;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../core/tilemap_loader.hpp"
+#include "../components/tilemap.hpp"
+#include "../components/tile_collision.hpp"
+#include <unordered_set>
+
+/**
+ * @brief Builds the solidity grid for a loaded tilemap.
+ * A cell is solid if any tile layer has one of the given tile IDs (GIDs) there.
+ * @param tilemap The map, with its layers already filled in.
+ * @param solidTileIds GIDs of the tiles flagged solid in the tilesets.
+ * @param options Supplies the physics layer/mask of the solid tiles.
+ */
+TileCollisionGridComponent buildTileCollisionGrid(const TilemapComponent& tilemap,
+    const std::unordered_set<int>& solidTileIds, const TilemapLoadOptions& options);
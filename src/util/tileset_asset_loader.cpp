@@ -65,6 +65,11 @@ std::unique_ptr<TilesetAsset> TilesetAssetLoader::loadFromFile(SDL_Renderer* ren
     const int atlasWidth = asset->columns * asset->tileWidth;
     const int atlasHeight = rows * asset->tileHeight;
 
+    // Without a renderer (headless) there is nothing to upload to; keep the metadata only.
+    if (!renderer) {
+        return asset;
+    }
+
     SDL_Texture* rawTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, atlasWidth, atlasHeight);
     if (!rawTexture) {
         std::cerr << "Failed to create texture atlas for tileset: " << SDL_GetError() << std::endl;
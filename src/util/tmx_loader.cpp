@@ -1,10 +1,14 @@
 #if WITH_FILE_LOADERS
 
 #include "tmx_loader.hpp"
+#include "../core/trace.hpp"
 #include "../components/tilemap.hpp"
 #include "../components/transform.hpp"
 #include "../components/collider.hpp"
 #include "../components/rigidbody.hpp"
+#include "../components/tile_collision.hpp"
+#include "tile_collision_builder.hpp"
+#include "collision_geometry.hpp"
 #include "../util/resource_manager.hpp"
 #include <tmxlite/Map.hpp>
 #include <tmxlite/TileLayer.hpp>
@@ -12,6 +16,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
+#include <unordered_set>
 
 // A helper to translate layer names to bitmasks.
 // This should probably live in a more central "PhysicsConfig" file later.
@@ -29,8 +34,12 @@ static BodyType getBodyTypeFromString(const std::string& type) {
     return BodyType::STATIC;
 }
 
+TmxLoader::TmxLoader(TilemapLoadOptions options)
+    : m_options(std::move(options)) {}
+
 bool TmxLoader::load(entt::registry& registry, entt::entity tilemapEntity,
     ResourceManager& resourceManager, const std::string& sourcePath) {
+    TRACE_ZONE("TmxLoader::load");
     tmx::Map map;
     if (!map.load(sourcePath)) {
         std::cerr << "TmxLoader: Failed to load map file: " << sourcePath << std::endl;
@@ -52,6 +61,9 @@ bool TmxLoader::load(entt::registry& registry, entt::entity tilemapEntity,
     tilemap.tileHeight = firstTileset.getTileSize().y;
     tilemap.tilesetAssetId = firstTileset.getName();
 
+    // Static walls waiting to be merged, when mergeCollisionRects is on.
+    std::vector<StaticCollisionRect> staticWalls;
+
     // Process each layer in the map
     for (const auto& layer : map.getLayers()) {
         if (layer->getType() == tmx::Layer::Type::Tile) {
@@ -86,31 +98,20 @@ bool TmxLoader::load(entt::registry& registry, entt::entity tilemapEntity,
 
         // parse object layers
         else if (layer->getType() == tmx::Layer::Type::Object) {
-            if (layer->getName() == "Collisions") {
+            // In TileGrid mode walls come from the tiles themselves, so the object layer is skipped.
+            if (layer->getName() == "Collisions" && m_options.collisionMode == TileCollisionMode::Objects) {
                 const auto& objectLayer = layer->getLayerAs<tmx::ObjectGroup>();
                 for (const auto& object : objectLayer.getObjects()) {
-                    // Create a new entity for each collision object
-                    const auto entity = registry.create();
-
-                    // Add a TransformComponent based on the object's position and size
                     const auto& aabb = object.getAABB();
-                    registry.emplace<TransformComponent>(entity,
-                        Vec2f{aabb.left + aabb.width / 2.f, aabb.top + aabb.height / 2.f}, // Position is center
-                        Vec2f{1.f, 1.f}
-                    );
-
-                    // Add a ColliderComponent
-                    auto& collider = registry.emplace<ColliderComponent>(entity);
-                    collider.size = {aabb.width, aabb.height};
-                    collider.is_static = true;
 
                     /// -- Parse all properties ---
+                    uint32_t layer_bits = 0;
                     uint32_t final_mask = 0;
                     bool hasRigidbody = false;
                     std::string bodyTypeStr = "STATIC"; // Default to static
                     for (const auto& prop : object.getProperties()) {
                         if (prop.getName() == "collisionLayerName") {
-                            collider.layer = getLayerBitmask(prop.getStringValue());
+                            layer_bits = getLayerBitmask(prop.getStringValue());
                         } else if (prop.getName() == "collisionMaskNames") {
                             const std::string& maskStr = prop.getStringValue();
                             std::stringstream ss(maskStr);
@@ -123,6 +124,29 @@ bool TmxLoader::load(entt::registry& registry, entt::entity tilemapEntity,
                             bodyTypeStr = prop.getStringValue();
                         }
                     }
+
+                    // Plain static walls are collected and merged after the loop.
+                    const bool isStaticWall = !hasRigidbody || getBodyTypeFromString(bodyTypeStr) == BodyType::STATIC;
+                    if (m_options.mergeCollisionRects && isStaticWall) {
+                        staticWalls.push_back({{aabb.left, aabb.top}, {aabb.width, aabb.height},
+                                               layer_bits, final_mask, hasRigidbody});
+                        continue;
+                    }
+
+                    // Create a new entity for each collision object
+                    const auto entity = registry.create();
+
+                    // Add a TransformComponent based on the object's position and size
+                    registry.emplace<TransformComponent>(entity,
+                        Vec2f{aabb.left + aabb.width / 2.f, aabb.top + aabb.height / 2.f}, // Position is center
+                        Vec2f{1.f, 1.f}
+                    );
+
+                    // Add a ColliderComponent
+                    auto& collider = registry.emplace<ColliderComponent>(entity);
+                    collider.size = {aabb.width, aabb.height};
+                    collider.is_static = true;
+                    collider.layer = layer_bits;
                     collider.mask = final_mask;
 
                     // Conditionally add and configure a RigidBodyComponent
@@ -142,6 +166,32 @@ bool TmxLoader::load(entt::registry& registry, entt::entity tilemapEntity,
             }
         }
     }
+
+    if (!staticWalls.empty()) {
+        const auto merged = mergeStaticCollisionRects(staticWalls);
+        for (const auto& rect : merged) {
+            createStaticColliderEntity(registry, rect);
+        }
+        std::cout << "TmxLoader: Merged " << staticWalls.size() << " collision rects into " << merged.size() << "." << std::endl;
+    }
+
+    if (m_options.collisionMode == TileCollisionMode::TileGrid) {
+        // Collect the GIDs of every tile flagged solid in any tileset.
+        std::unordered_set<int> solidTileIds;
+        for (const auto& tileset : map.getTilesets()) {
+            for (const auto& tile : tileset.getTiles()) {
+                for (const auto& prop : tile.properties) {
+                    if (prop.getName() == m_options.solidPropertyName &&
+                        prop.getType() == tmx::Property::Type::Boolean && prop.getBoolValue()) {
+                        solidTileIds.insert(static_cast<int>(tileset.getFirstGID() + tile.ID));
+                    }
+                }
+            }
+        }
+        registry.emplace_or_replace<TileCollisionGridComponent>(tilemapEntity,
+            buildTileCollisionGrid(tilemap, solidTileIds, m_options));
+    }
+
     std::cout << "TmxLoader: Successfully loaded map '" << sourcePath << "'" << std::endl;
     return true;
 }
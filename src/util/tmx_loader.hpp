@@ -4,8 +4,13 @@
 
 class TmxLoader : public ITilemapLoader {
 public:
+    explicit TmxLoader(TilemapLoadOptions options = {});
+
     bool load(entt::registry& registry,
               entt::entity tilemapEntity,
               ResourceManager& resourceManager,
               const std::string& sourcePath) override;
+
+private:
+    TilemapLoadOptions m_options;
 };
@@ -1,6 +1,7 @@
 #if WITH_FILE_LOADERS
 
 #include "toml_scene_loader.hpp"
+#include "../core/trace.hpp"
 #include "resource_manager.hpp"
 #include "tmx_loader.hpp"
 #include "../components/transform.hpp"
@@ -19,6 +20,7 @@
 #include "../core/behaviors/collectible_behavior.hpp"
 #include "../core/context.hpp"
 #include "../core/blackboard_keys.hpp"
+#include <algorithm>
 #include <iostream>
 
 #include "../components/intent.hpp"
@@ -28,7 +30,17 @@ void TomlSceneLoader::parseTilemap(entt::registry &registry, SDL_Renderer *rende
     toml::impl::table_proxy_pair<false>::value_type &compData) {
     // We parse this in Pass 1 because it doesn't reference other entities.
     // We create a temporary loader to do the job.
-    TmxLoader tmxLoader;
+    TilemapLoadOptions options;
+    // collision = "tiles" builds a solidity grid from tiles flagged solid instead of wall entities.
+    const std::string collisionMode = (*compData.as_table())["collision"].value_or<std::string>("objects");
+    if (collisionMode == "tiles") {
+        options.collisionMode = TileCollisionMode::TileGrid;
+    } else if (collisionMode != "objects") {
+        std::cerr << "TomlSceneLoader: Unknown tilemap collision mode '" << collisionMode << "', using 'objects'." << std::endl;
+    }
+    // mergeCollisions = true merges per-tile wall rects into a few large colliders at load time.
+    options.mergeCollisionRects = (*compData.as_table())["mergeCollisions"].value_or(false);
+    TmxLoader tmxLoader(options);
     std::string mapFile = compData.as_table()->get("mapFile")->value_or<std::string>("");
     if (!mapFile.empty()) {
         std::string fullMapPath = resourceManager->getBasePath() + mapFile;
@@ -44,13 +56,18 @@ bool TomlSceneLoader::load(entt::registry& registry,
     SDL_Renderer* renderer,
     ResourceManager* resourceManager,
     const std::string& sourcePath) {
+    TRACE_ZONE("TomlSceneLoader::load");
     try {
         toml::table sceneData = toml::parse_file(sourcePath);
 
         // --- Load world and context data first ---
         // Set ScreenDimensions from the renderer
-        int screenW, screenH;
-        SDL_GetRendererOutputSize(renderer, &screenW, &screenH);
+        int screenW = DEFAULT_SCREEN_WIDTH, screenH = DEFAULT_SCREEN_HEIGHT;
+        // Headless runs may have no renderer; keep the default logical size then.
+        if (renderer && SDL_GetRendererOutputSize(renderer, &screenW, &screenH) != 0) {
+            screenW = DEFAULT_SCREEN_WIDTH;
+            screenH = DEFAULT_SCREEN_HEIGHT;
+        }
         registry.ctx().emplace<ScreenDimensions>(static_cast<float>(screenW), static_cast<float>(screenH));
 
         // Load WorldBounds from the TOML file
@@ -64,6 +81,25 @@ bool TomlSceneLoader::load(entt::registry& registry,
                 };
                 registry.ctx().emplace<WorldBounds>(worldBounds);
             }
+            // Optional tuning for the spatial hash broad phase.
+            if (auto cellSize = (*worldData)["broadPhaseCellSize"].value<float>()) {
+                if (*cellSize > 0.0f) {
+                    registry.ctx().emplace<BroadPhaseSettings>(BroadPhaseSettings{*cellSize});
+                } else {
+                    std::cerr << "TomlSceneLoader: world.broadPhaseCellSize must be positive, using the default." << std::endl;
+                }
+            }
+            // Optional: report a CollisionEvent every tick two colliders keep touching, not only when they start and stop.
+            if (auto reportStay = (*worldData)["collisionStayEvents"].value<bool>()) {
+                registry.ctx().emplace<CollisionEventSettings>(CollisionEventSettings{*reportStay});
+            }
+            // Optional: when resting bodies fall asleep. sleepTicks = 0 keeps every body awake.
+            if ((*worldData).contains("sleepSpeed") || (*worldData).contains("sleepTicks")) {
+                PhysicsSleepSettings sleepSettings;
+                sleepSettings.speedThreshold = (*worldData)["sleepSpeed"].value_or(sleepSettings.speedThreshold);
+                sleepSettings.ticksToSleep = std::max(0, (*worldData)["sleepTicks"].value_or(sleepSettings.ticksToSleep));
+                registry.ctx().emplace<PhysicsSleepSettings>(sleepSettings);
+            }
         }
 
         // --- Preload all required assets first ---
@@ -131,7 +167,9 @@ bool TomlSceneLoader::load(entt::registry& registry,
                     // If the entity has a sprite, update its dimensions from the loaded asset
                     if (registry.all_of<SpriteComponent>(entity)) {
                         auto& sprite = registry.get<SpriteComponent>(entity);
-                        if (const auto* asset = resourceManager->getSpriteAsset(sprite.assetId)) {
+                        // Resolve the asset handle once so systems never look it up by string.
+                        sprite.assetHandle = resourceManager->getSpriteAssetHandle(sprite.assetId);
+                        if (const auto* asset = resourceManager->getSpriteAsset(sprite.assetHandle)) {
                             sprite.width = asset->width;
                             sprite.height = asset->height;
                         }
@@ -150,8 +188,8 @@ bool TomlSceneLoader::load(entt::registry& registry,
 
                         // If the camera has a target in its blackboard, sync its position now
                         const auto& blackboard = registry.get<BlackboardComponent>(entity);
-                        if (auto it = blackboard.values.find(BlackboardKeys::Camera::Target); it != blackboard.values.end()) {
-                            entt::entity targetEntity = std::any_cast<entt::entity>(it->second);
+                        if (const auto* target = blackboard.get<entt::entity>(BlackboardKeys::Camera::Target)) {
+                            entt::entity targetEntity = *target;
                             if (registry.valid(targetEntity) && registry.all_of<TransformComponent>(targetEntity)) {
                                 const auto& targetTransform = registry.get<TransformComponent>(targetEntity);
                                 auto& cameraTransform = registry.get<TransformComponent>(entity);
@@ -280,7 +318,7 @@ void TomlSceneLoader::parseStateMachine(entt::registry& registry, entt::entity e
                     for (auto& cond_elem : *conditionsArr) {
                         if (auto* cond_tbl = cond_elem.as_table()) {
                             transition.conditions.emplace_back(
-                                cond_tbl->get("key")->value_or<std::string>(""),
+                                entt::hashed_string::value(cond_tbl->get("key")->value_or<std::string>("").c_str()),
                                 cond_tbl->get("value")->value_or(false)
                                 );
                         }
@@ -308,24 +346,35 @@ void TomlSceneLoader::parseBlackboard(entt::registry& registry, entt::entity ent
 
     for (const auto& [key, val] : data) {
         std::string keyStr = std::string(key.str());
+        // Keys are hashed here, once; systems look them up by their BlackboardKeys constants.
+        const entt::id_type keyId = entt::hashed_string::value(keyStr.c_str());
 
-        // Check the TOML node's type and insert the corresponding C++ type into the std::any map.
+        // Check the TOML node's type and store the corresponding C++ type.
+        bool isStored = true;
         if (val.is_string()) {
-            // Special case: If this string is an entity name reference, store the entity handle.
-            // Otherwise, store it as a plain string.
+            // Strings are only supported as entity name references, stored as the entity handle.
             std::string str_val = val.as_string()->get();
             if (nameToEntityMap.count(str_val)) {
-                blackboard.values[keyStr] = nameToEntityMap.at(str_val);
+                isStored = blackboard.set(keyId, nameToEntityMap.at(str_val));
             } else {
-                blackboard.values[keyStr] = str_val;
+                std::cerr << "TomlSceneLoader: Blackboard key '" << keyStr << "' names unknown entity '" << str_val << "', skipping." << std::endl;
             }
         } else if (val.is_boolean()) {
-            blackboard.values[keyStr] = val.as_boolean()->get();
+            isStored = blackboard.set(keyId, val.as_boolean()->get());
         } else if (val.is_floating_point()) {
-            blackboard.values[keyStr] = static_cast<float>(val.as_floating_point()->get());
+            isStored = blackboard.set(keyId, static_cast<float>(val.as_floating_point()->get()));
         } else if (val.is_integer()) {
             // TOML integers are 64-bit, so cast to a reasonable default like int
-            blackboard.values[keyStr] = static_cast<int>(val.as_integer()->get());
+            isStored = blackboard.set(keyId, static_cast<int>(val.as_integer()->get()));
+        } else if (const auto* array = val.as_array(); array && array->size() == 2) {
+            // [x, y] is a Vec2f.
+            isStored = blackboard.set(keyId, Vec2f{(*array)[0].value_or(0.0f), (*array)[1].value_or(0.0f)});
+        } else {
+            std::cerr << "TomlSceneLoader: Blackboard key '" << keyStr << "' has an unsupported type, skipping." << std::endl;
+        }
+        if (!isStored) {
+            std::cerr << "TomlSceneLoader: Blackboard is full (" << BlackboardComponent::MAX_ENTRIES
+                      << " entries), skipping key '" << keyStr << "'." << std::endl;
         }
     }
 }
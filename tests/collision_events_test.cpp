@@ -0,0 +1,113 @@
+#include "../src/systems/collision_system.hpp"
+#include "../src/components/rigidbody.hpp"
+#include "../src/events/collision.hpp"
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+/**
+ * Checks that the CollisionSystem ends touching pairs whose bodies were not found touching again,
+ * unless both sides are at rest (asleep or static), in which case the pair carries over.
+ * Returns non-zero if any check fails.
+ */
+
+namespace {
+    int g_failures = 0;
+
+    void check(bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << std::endl;
+            ++g_failures;
+        }
+    }
+
+    struct EventLog {
+        std::vector<CollisionEvent> events;
+        void onCollision(const CollisionEvent& event) { events.push_back(event); }
+
+        size_t count(CollisionPhase phase) const {
+            size_t n = 0;
+            for (const auto& event : events) n += event.phase == phase;
+            return n;
+        }
+    };
+
+    struct Scene {
+        entt::registry registry;
+        EventLog log;
+        CollisionSystem collisionSystem{{0, 0, 1024, 1024}};
+        entt::entity body{entt::null};
+        entt::entity trigger{entt::null};
+
+        Scene() {
+            auto& dispatcher = registry.ctx().emplace<entt::dispatcher>();
+            dispatcher.sink<CollisionEvent>().connect<&EventLog::onCollision>(&log);
+            collisionSystem.init(registry);
+
+            // A static trigger, so the overlapping body is never pushed out and keeps touching it.
+            trigger = registry.create();
+            registry.emplace<TransformComponent>(trigger, Vec2f{100.0f, 100.0f});
+            auto& triggerCollider = registry.emplace<ColliderComponent>(trigger);
+            triggerCollider.size = {64.0f, 64.0f};
+            triggerCollider.layer = 1;
+            triggerCollider.mask = 1;
+            triggerCollider.is_trigger = true;
+            triggerCollider.is_static = true;
+
+            body = registry.create();
+            registry.emplace<TransformComponent>(body, Vec2f{110.0f, 110.0f});
+            auto& bodyCollider = registry.emplace<ColliderComponent>(body);
+            bodyCollider.size = {16.0f, 16.0f};
+            bodyCollider.layer = 1;
+            bodyCollider.mask = 1;
+            registry.emplace<RigidBodyComponent>(body, RigidBodyComponent{.bodyType = BodyType::DYNAMIC});
+        }
+
+        // Runs one tick and returns the events it reported.
+        EventLog tick() {
+            log.events.clear();
+            // The collision system never touches input or resources, so it only needs something to refer to.
+            alignas(std::max_align_t) static unsigned char unused[64];
+            collisionSystem.update(registry, *reinterpret_cast<InputManager*>(unused), *reinterpret_cast<ResourceManager*>(unused), 1.0f / 60.0f);
+            registry.ctx().get<entt::dispatcher>().update();
+            return log;
+        }
+    };
+
+    void awakeBodyLosingItsColliderEnds() {
+        Scene scene;
+        check(scene.tick().count(CollisionPhase::Begin) == 1, "awake body: touching the trigger begins");
+        scene.registry.remove<ColliderComponent>(scene.body);
+        check(scene.tick().count(CollisionPhase::End) == 1, "awake body: removing its collider ends the pair");
+        check(scene.tick().events.empty(), "awake body: nothing is reported after the end");
+    }
+
+    void sleepingBodyLosingItsColliderEnds() {
+        Scene scene;
+        check(scene.tick().count(CollisionPhase::Begin) == 1, "sleeping body: touching the trigger begins");
+        scene.registry.emplace<SleepingComponent>(scene.body);
+        check(scene.tick().count(CollisionPhase::End) == 0, "sleeping body: a resting pair does not end");
+        scene.registry.remove<ColliderComponent>(scene.body);
+        check(scene.tick().count(CollisionPhase::End) == 1, "sleeping body: removing its collider ends the pair");
+        check(scene.tick().events.empty(), "sleeping body: nothing is reported after the end");
+    }
+
+    void staticSideLosingItsColliderEnds() {
+        Scene scene;
+        scene.tick();
+        scene.registry.emplace<SleepingComponent>(scene.body);
+        scene.tick();
+        scene.registry.remove<ColliderComponent>(scene.trigger);
+        check(scene.tick().count(CollisionPhase::End) == 1, "static side: removing its collider ends the pair");
+    }
+}
+
+int main() {
+    awakeBodyLosingItsColliderEnds();
+    sleepingBodyLosingItsColliderEnds();
+    staticSideLosingItsColliderEnds();
+    if (g_failures == 0) {
+        std::cout << "collision_events_test: all checks passed" << std::endl;
+    }
+    return g_failures == 0 ? 0 : 1;
+}